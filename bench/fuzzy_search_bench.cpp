@@ -0,0 +1,137 @@
+// Скорость нечёткого поиска по ФИО (ContactManager::fuzzySearch) против прямого перебора:
+// расстояние Левенштейна от запроса до каждого ключа NameIndex обычным DP.
+// Запросы - имена существующих контактов с одной опечаткой.
+// Сборка и запуск - см. README.md. Необязательный аргумент - число контактов
+
+#include "FileRepository.h"
+#include "ContactManager.h"
+#include "NameIndex.h"
+#include <iostream>
+#include <fstream>
+#include <filesystem>
+#include <algorithm>
+#include <random>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+
+using namespace std;
+
+namespace {
+
+mt19937 rng(7);
+
+const char* SYLLABLES[] = {"a", "b", "c", "d", "e", "f", "g", "h", "i", "k", "l", "m", "n", "o", "p", "r", "s",
+                           "t", "u", "v", "а", "б", "в", "г", "д", "е", "ж", "з", "и", "к", "л", "м", "н", "о",
+                           "п", "р", "с", "т", "у", "ш", "я"};
+const size_t SYLLABLE_COUNT = sizeof(SYLLABLES) / sizeof(SYLLABLES[0]);
+
+string random_word() {
+    string s;
+    for (int i = 2 + rng() % 6; i > 0; --i) s += SYLLABLES[rng() % SYLLABLE_COUNT];
+    return s;
+}
+
+// Символы строки UTF-8 (в ключах только 1- и 2-байтовые)
+vector<uint32_t> decode(const string& s) {
+    vector<uint32_t> out;
+    for (size_t i = 0; i < s.size();) {
+        unsigned char c = s[i];
+        if (c < 0x80) {
+            out.push_back(c);
+            ++i;
+        } else {
+            out.push_back(((c & 0x1F) << 6) | (s[i + 1] & 0x3F));
+            i += 2;
+        }
+    }
+    return out;
+}
+
+// Наименьшее число правок, за которое query входит в text подстрокой (как считает fuzzySearch)
+size_t levenshtein_substring(const string& query, const string& text) {
+    const vector<uint32_t> p = decode(query), t = decode(text);
+    vector<size_t> column(p.size() + 1);
+    for (size_t i = 0; i <= p.size(); ++i) column[i] = i;
+    size_t best = p.size();
+    for (uint32_t c : t) {
+        size_t diagonal = 0;
+        column[0] = 0;
+        for (size_t i = 1; i <= p.size(); ++i) {
+            size_t up = column[i];
+            column[i] = min({column[i] + 1, column[i - 1] + 1, diagonal + (p[i - 1] == c ? 0 : 1)});
+            diagonal = up;
+        }
+        best = min(best, column[p.size()]);
+    }
+    return best;
+}
+
+// Заменить второй символ запроса на "q" - одна опечатка
+string with_typo(string s) {
+    size_t begin = 1;
+    while (begin < s.size() && (static_cast<unsigned char>(s[begin]) & 0xC0) == 0x80) ++begin;
+    size_t end = begin + 1;
+    while (end < s.size() && (static_cast<unsigned char>(s[end]) & 0xC0) == 0x80) ++end;
+    if (begin < s.size()) s.replace(begin, end - begin, "q");
+    return s;
+}
+
+double ms_since(chrono::steady_clock::time_point start) {
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const size_t count = argc > 1 ? strtoul(argv[1], nullptr, 10) : 100000;
+    const string filename = "fuzzy_bench.json";
+    filesystem::remove(filename);
+    filesystem::remove(filename + ".journal");
+    ofstream(filename) << "[]";
+
+    {
+        FileRepository repository(filename);
+        ContactManager manager(&repository);
+
+        vector<Contact> contacts;
+        for (size_t i = 0; i < count; ++i) {
+            contacts.push_back(Contact(random_word(), random_word(), random_word(), "addr", "01.01.1990",
+                                       "e" + to_string(i) + "@x.ru", PhoneList{}));
+        }
+        repository.replaceAllContacts(contacts);
+
+        vector<string> keys;
+        for (const auto& contact : contacts) keys.push_back(NameIndex::key_of(contact));
+
+        const size_t LINEAR_QUERIES = 20;   // перебор медленный - его запросов меньше
+        for (int fullName = 1; fullName >= 0; --fullName) {
+            vector<string> queries;
+            for (int i = 0; i < 200; ++i) {
+                const Contact& c = contacts[rng() % count];
+                queries.push_back(with_typo(NameIndex::fold(fullName ? c.ref_firstName() + " " + c.ref_lastName()
+                                                                      : c.ref_lastName())));
+            }
+
+            auto start = chrono::steady_clock::now();
+            size_t found = 0;
+            for (const auto& query : queries) found += manager.fuzzySearch(query, 1, 10).size();
+            const double indexed = ms_since(start) / queries.size();
+
+            start = chrono::steady_clock::now();
+            size_t matched = 0;
+            for (size_t i = 0; i < LINEAR_QUERIES; ++i) {
+                for (const auto& key : keys) matched += levenshtein_substring(queries[i], key) <= 1;
+            }
+            const double linear = ms_since(start) / LINEAR_QUERIES;
+
+            cout << (fullName ? "full name queries:    " : "surname-only queries: ")
+                 << "fuzzySearch " << indexed << " ms/query, linear Levenshtein " << linear << " ms/query"
+                 << " (" << count << " contacts; found " << found << ", matched " << matched << ")\n";
+        }
+    }
+
+    filesystem::remove(filename);
+    filesystem::remove(filename + ".journal");
+    return 0;
+}
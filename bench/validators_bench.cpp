@@ -0,0 +1,61 @@
+// Скорость Validators против прежней реализации на regex (tests/ValidatorsReference.h).
+// Сборка и запуск - см. README.md. Необязательный аргумент - число повторов
+
+#include "Validators.h"
+#include "../tests/ValidatorsReference.h"
+#include <iostream>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <cstdlib>
+
+using namespace std;
+
+namespace {
+
+const vector<string> EMAILS = {"ivan.petrov@example.com", "anna_smirnova+news@mail.ru", "bad@@x.ru", "olga.k@spbstu.ru"};
+const vector<string> PHONES = {"+7(812)123-45-67", "88121234567", "+7 921 000 11 22", "12345"};
+const vector<string> NAMES  = {"Ivan", "Anna-Maria", "Petrov", "Smith John"};
+
+// проверок в секунду; accepted - сколько строк принято (чтобы вызовы не выбросил оптимизатор)
+template <typename Email, typename Phone, typename Name>
+double measure(long rounds, int checksPerRound, Email email, Phone phone, Name name, long& accepted) {
+    accepted = 0;
+    auto start = chrono::steady_clock::now();
+    for (long i = 0; i < rounds; ++i) {
+        accepted += email(EMAILS[i & 3]);
+        accepted += phone(PHONES[i & 3]);
+        accepted += name(NAMES[i & 3]);
+    }
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    return checksPerRound * rounds / seconds;
+}
+
+bool none(const string&) { return false; }
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const long rounds = argc > 1 ? atol(argv[1]) : 2000000;
+
+    long oldAccepted, newAccepted;
+    double oldMixed = measure(rounds, 3,
+        [](const string& s) { return reference::validate_email(s); },
+        [](const string& s) { return reference::validate_phone(s); },
+        [](const string& s) { return reference::validate_name(s); }, oldAccepted);
+    double newMixed = measure(rounds, 3,
+        [](const string& s) { return Validators::validate_email(s); },
+        [](const string& s) { return Validators::validate_phone(s); },
+        [](const string& s) { return Validators::validate_name(s); }, newAccepted);
+    if (oldAccepted != newAccepted) {
+        cerr << "validators_bench: implementations disagree\n";
+        return 1;
+    }
+
+    double oldEmail = measure(rounds, 1, [](const string& s) { return reference::validate_email(s); }, none, none, oldAccepted);
+    double newEmail = measure(rounds, 1, [](const string& s) { return Validators::validate_email(s); }, none, none, newAccepted);
+
+    cout << "email + phone + name: regex " << oldMixed / 1e6 << " M/s, new " << newMixed / 1e6 << " M/s\n";
+    cout << "email only:           regex " << oldEmail / 1e6 << " M/s, new " << newEmail / 1e6 << " M/s\n";
+    return 0;
+}
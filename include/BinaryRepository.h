@@ -0,0 +1,107 @@
+#pragma once
+#include "IContactRepository.h"
+#include "EmailIndex.h"
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+
+using namespace std;
+
+// Хранилище в компактном бинарном снимке (вместо JSON).
+//
+// Формат (все числа little-endian):
+//   "PBKB"            - сигнатура
+//   u16 version       - версия формата (сейчас 1)
+//   u16 flags         - зарезервировано, 0
+//   u32 count         - число контактов
+//   u32 offsets[count]- смещение каждой записи от начала файла
+//   u32 byEmail[count]- номера записей, отсортированные по email, для двоичного поиска
+//   записи:
+//     6 строк (имя, фамилия, отчество, адрес, дата рождения, email): u32 длина + байты
+//     u16 число телефонов, для каждого: u8 тип, u8 формат и
+//       формат 0 ("8XXXXXXXXXX") или 1 ("+7XXXXXXXXXX") - u64 с последними 10 цифрами,
+//       формат 2 (любая другая запись) - строка как есть
+class BinaryRepository : public IContactRepository {
+private:
+    string m_filename;
+    vector<Contact> m_contacts;
+    EmailIndex m_emailIndex;   // email -> позиция в m_contacts
+
+    bool loadFromFile();
+    bool saveToFile(const string& filename) const;
+    void rebuildIndex();
+
+public:
+    // Детали формата - общие с MappedRepository
+    static const char MAGIC[4];
+    static const size_t HEADER_SIZE = 12; // сигнатура + версия + флаги + число записей
+    static const uint16_t FORMAT_VERSION = 1;
+    static const size_t MAX_PHONES = 0xFFFF;   // больше не помещается в счётчик - снимок не пишется
+
+    enum PhoneFormat : uint8_t {
+        PHONE_PLAIN_8 = 0,  // 8XXXXXXXXXX
+        PHONE_PLUS_7  = 1,  // +7XXXXXXXXXX
+        PHONE_RAW     = 2   // любая другая запись (со скобками, дефисами и т.п.)
+    };
+
+    // Чтение из буфера с проверкой границ: при выходе за конец ok становится false
+    struct Reader {
+        const char* data;
+        size_t size;
+        size_t pos;
+        bool ok;
+
+        bool need(size_t n) {
+            if (!ok || pos > size || size - pos < n) ok = false;
+            return ok;
+        }
+
+        uint64_t uint(int bytes) {
+            if (!need(bytes)) return 0;
+            uint64_t v = 0;
+            for (int i = 0; i < bytes; ++i)
+                v |= static_cast<uint64_t>(static_cast<unsigned char>(data[pos + i])) << (8 * i);
+            pos += bytes;
+            return v;
+        }
+
+        string_view view() {
+            uint32_t len = static_cast<uint32_t>(uint(4));
+            if (!need(len)) return string_view();
+            string_view s(data + pos, len);
+            pos += len;
+            return s;
+        }
+
+        void str(string& out) {
+            string_view s = view();
+            out.assign(s.data(), s.size());
+        }
+    };
+
+    static string phoneFromDigits(PhoneFormat format, uint64_t digits);
+
+    BinaryRepository(const string& filename);
+    ~BinaryRepository() = default;
+
+    // Каждое изменение сразу переписывает снимок. Если записать не удалось - изменение
+    // отменяется и в памяти, а метод возвращает false
+    bool addContact(const Contact& contact) override;
+    bool removeContact(const string& email) override;
+    bool updateContact(const Contact& contact) override;
+    bool addContact(Contact&& contact) override;
+    bool updateContact(Contact&& contact) override;
+    Contact getContact(const string& email) const override;
+    vector<Contact> getAllContacts() const override;
+    bool replaceAllContacts(const vector<Contact>& contacts) override;
+    bool replaceAllContacts(vector<Contact>&& contacts) override;
+
+    // Кодирование/декодирование снимка целиком
+    static bool readSnapshot(const string& filename, vector<Contact>& contacts);
+    static bool writeSnapshot(const string& filename, const vector<Contact>& contacts);
+
+    // Конвертеры между contacts.json и бинарным снимком
+    static bool importJson(const string& jsonFilename, const string& binaryFilename);
+    static bool exportJson(const string& binaryFilename, const string& jsonFilename);
+};
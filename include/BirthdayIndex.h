@@ -0,0 +1,39 @@
+#ifndef BIRTHDAYINDEX_H
+#define BIRTHDAYINDEX_H
+
+#include "Date.h"
+#include <set>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <utility>
+
+using namespace std;
+
+// Индекс по дате рождения. Два упорядоченных набора слотов:
+// по самой дате (для запросов "возраст от X до Y" - это диапазон дат)
+// и по дню в году ММДД (для "дни рождения в ближайшие N дней" - один или два диапазона,
+// если период переходит через Новый год). Контакты без даты рождения не индексируются
+class BirthdayIndex {
+public:
+    // слоты с возрастом от minAge до maxAge полных лет на дату today, от старших к младшим
+    vector<size_t> byAge(int minAge, int maxAge, const Date& today) const;
+
+    // слоты, у которых день рождения в ближайшие days дней (сегодня - тоже), по порядку наступления
+    vector<size_t> upcoming(int days, const Date& today) const;
+
+    void insert(size_t slot, const Date& birthDate);
+    void erase(size_t slot, const Date& birthDate);
+    void clear();
+
+private:
+    set<pair<int32_t, size_t>> m_byDate;     // (день от 01.01.1970, слот)
+    set<pair<int, size_t>> m_byMonthDay;     // (ММДД, слот)
+
+    // добавить слоты с ММДД в [from, to]
+    void collectRange(int from, int to, vector<size_t>& result) const;
+    // то же, но 29.02 - только если withLeapDay (его день в этом году попал в период)
+    void collectMonthDays(int from, int to, bool withLeapDay, vector<size_t>& result) const;
+};
+
+#endif // BIRTHDAYINDEX_H
@@ -4,38 +4,79 @@
 
 #include <list>
 #include <string>
+#include <istream>
+#include <functional>
+#include <cstdint>
+#include <vector>
 #include "PhoneNumber.h"
+#include "SmallVector.h"
+#include "Date.h"
+#include "JsonWriter.h"
 #include <../third_party/json.hpp>
 
 using json = nlohmann::json;
 using namespace std;
 
+// Обычно у контакта 1-3 телефона - они лежат прямо внутри объекта, без отдельных выделений памяти
+using PhoneList = SmallVector<PhoneNumber, 3>;
+
 class Contact {
 private:
     string firstName;          // Имя
     string lastName;           // Фамилия
     string patronymic;         // Отчество
     string address;            // Адрес
-    string birthDate;          // Дата рождения
     string email;              // Email
-    list<PhoneNumber> phones;  // Телефоны (рабочий, домашний, служебный)
+    PhoneList phones;          // Телефоны (рабочий, домашний, служебный)
+    Date birthDate;            // Дата рождения (день от 01.01.1970; Date() - не задана)
+    string birthDateText;      // дата рождения как записана, если это не ровно "ДД.ММ.ГГГГ" (тогда birthDate не задана)
+
+    // Сохранённую дату разбираем, только если toString вернёт ту же строку - иначе
+    // (другой вид записи, несуществующий день) храним текст как есть, чтобы сохранение его не потеряло
+    void assign_birthDate(const string& text);
+
+    // Биты Field полей, которые прошли проверку. Поле проверяется сразу, когда его задают
+    // (конструктор, сеттеры, загрузка из JSON), поэтому чтение маски - просто чтение.
+    // У пустого контакта проходит только пустое отчество. Копируется вместе с контактом
+    uint8_t m_valid = FIELD_PATRONYMIC;
+
+    void set_valid(uint8_t fields, bool valid);
+    void revalidate(uint8_t fields);   // заново проверить поля fields
+
+    PhoneList prompt_for_phones();  
 
-    list<PhoneNumber> prompt_for_phones();  
+    friend class ContactSaxReader; // потоковый загрузчик заполняет поля напрямую
 public:
+    // Поля, которые проверяет is_valid (биты маски валидности)
+    enum Field : uint8_t {
+        FIELD_FIRST_NAME  = 1 << 0,   // не пустое и validate_name
+        FIELD_LAST_NAME   = 1 << 1,   // не пустое и validate_name
+        FIELD_PATRONYMIC  = 1 << 2,   // пустое или validate_name
+        FIELD_EMAIL       = 1 << 3,   // validate_email
+        FIELD_PHONES      = 1 << 4,   // хотя бы один телефон, все валидны
+        FIELD_BIRTH_DATE  = 1 << 5,   // validate_birthDate
+        FIELD_ALL         = (1 << 6) - 1
+    };
+
     // Конструкторы
     // Дефолтный конструктор
     Contact() = default;
-    Contact(const string& firstName,
-            const string& lastName, 
-            const string& patronymic,
-            const string& address,
-            const string& birthDate,
-            const string& email,
-            const list<PhoneNumber> phones);
+    // параметры по значению: временные строки и список телефонов перемещаются, а не копируются
+    Contact(string firstName,
+            string lastName, 
+            string patronymic,
+            string address,
+            string birthDate,
+            string email,
+            PhoneList phones);
     // конструктор копирования
-    Contact(const Contact& other);
+    Contact(const Contact& other) = default;
+    // конструктор перемещения - забирает строки и телефоны без копирования
+    Contact(Contact&& other) noexcept = default;
+    Contact& operator=(const Contact& other) = default;
+    Contact& operator=(Contact&& other) noexcept = default;
     // деструктор
-    ~Contact();
+    ~Contact() = default;
     
     // Геттеры
     string get_firstName() const;
@@ -44,7 +85,18 @@ public:
     string get_address() const;
     string get_birthDate() const;
     string get_email() const;
-    list<PhoneNumber> get_phones() const;
+    PhoneList get_phones() const;
+
+    // Доступ без копирования - для поиска, сортировки и вывода.
+    // Ссылка живёт, пока жив контакт и пока поле не изменено
+    const string& ref_firstName() const { return firstName; }
+    const string& ref_lastName() const { return lastName; }
+    const string& ref_patronymic() const { return patronymic; }
+    const string& ref_address() const { return address; }
+    const string& ref_email() const { return email; }
+    const PhoneList& ref_phones() const { return phones; }   // только для чтения
+    const Date& ref_birthDate() const { return birthDate; }    // сравнивается как число; не задана и для даты, сохранённой текстом
+    bool has_birthDate() const { return birthDate.is_set() || !birthDateText.empty(); }
 
     
     // Сеттеры
@@ -54,10 +106,19 @@ public:
     void set_address(const string& newAddress);
     bool set_birthDate(const string& newBirthDate);
     bool set_email(const string& newEmail);
-    bool set_phones(const list<PhoneNumber>& newPhones);
+    bool set_phones(const PhoneList& newPhones);
     
-    // Валидация
-    bool is_valid() const;
+    // Валидация. Поля проверены при установке - здесь только чтение маски, O(1),
+    // и константный контакт можно проверять из разных потоков сразу
+    bool is_valid() const { return m_valid == FIELD_ALL; }
+    string validation_error() const;   // текст первой ошибки для пользователя ("" - контакт валиден)
+    bool is_field_valid(Field field) const { return (m_valid & field) == field; }
+    uint8_t validation_mask() const { return m_valid; }   // биты прошедших проверку полей
+
+    // Перепроверить все поля заново (без сообщений об ошибках)
+    void validate();
+    // То же для набора контактов за один раз, параллельно (разные контакты - в разных потоках)
+    static void validate_all(vector<Contact>& contacts);
     
     // Статические методы валидации
     static bool validate_name(const string& name);   // static можно вызывать без объекта
@@ -74,6 +135,11 @@ public:
     string toJson() const;                        // Контакт в JSON
     static Contact fromJson(const string& json);  // JSON в Контакт
     json toJsonObj() const;
+    void writeJson(JsonWriter& writer) const;   // сразу в поток, без промежуточного json (ключи по алфавиту, как в toJsonObj)
+
+    // Потоковое чтение JSON-массива контактов за один проход, без промежуточного DOM:
+    // каждый прочитанный контакт передаётся в onContact. false - ошибка разбора (текст в error)
+    static bool readJsonArray(istream& in, const function<void(Contact&)>& onContact, string& error);
 
     // чтобы удобно выводить содержимое объекта (имя и телефон) в виде строки
     string toString() const;
@@ -1,6 +1,7 @@
 #pragma once
 #include "Contact.h"
 #include "IContactRepository.h"
+#include "SortEngine.h"
 #include <string>
 #include <vector>
 
@@ -14,12 +15,26 @@ public:
     explicit ContactManager(IContactRepository* repo);
 
     bool addContact(const Contact& contact);
+    bool addContact(Contact&& contact);
     bool removeContact(const string& email);
     bool updateContact(const Contact& contact);
+    bool updateContact(Contact&& contact);
     bool updateAllContacts(const vector<Contact>& contacts);
+    bool updateAllContacts(vector<Contact>&& contacts);
     Contact getContact(const string& email) const;
     vector<Contact> getAllContacts() const;
+    vector<Contact> getSortedContacts(SortField field, bool ascending) const; // без записи в хранилище
+    vector<Contact> getSortedContacts(const vector<SortEngine::Key>& keys) const; // по нескольким полям
 
-    vector<Contact> searchByName(const string& name) const;
+    vector<Contact> searchByName(const string& name, bool transliterate = false) const;
+    vector<Contact> fuzzySearch(const string& query, size_t maxErrors, size_t k) const; // с опечатками
+    vector<Contact> searchText(const string& query, size_t k = 20) const; // по всем полям, по релевантности
+    vector<Contact> findByEmailSuffix(const string& suffix) const;      // "@company.ru" - все из компании
+    size_t countByEmailDomain(const string& domain) const;
+    vector<pair<string, size_t>> emailDomainCounts() const;              // домены от самых частых
+    vector<Contact> findByAge(int minAge, int maxAge) const;
+    vector<Contact> upcomingBirthdays(int days) const;                    // в ближайшие days дней
+    vector<Contact> findByPhone(const string& number) const; // точное совпадение номера в любой записи
+    vector<Contact> findByPhonePrefix(const string& digits, size_t limit = 20) const; // по началу номера
     IContactRepository* getRepository() const { return m_repository; }
 };
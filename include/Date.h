@@ -0,0 +1,54 @@
+#ifndef DATE_H
+#define DATE_H
+
+#include <string>
+#include <cstdint>
+
+using namespace std;
+
+// Календарная дата, хранится одним числом - днём от 01.01.1970 (раньше - отрицательные).
+// Такие даты сравниваются и вычитаются как числа. Date() - дата не задана
+class Date {
+public:
+    Date() = default;
+
+    // Дата по году, месяцу и дню; несуществующая дата (31.02, год вне 0..9999) - не задана
+    static Date from_ymd(int year, int month, int day);
+    static Date from_days(int32_t days);
+
+    // "ДД.ММ.ГГГГ" (разбор как в Validators::parse_date); несуществующая дата - не задана
+    static Date parse(const string& text);
+
+    static Date today();   // сегодня по местному времени
+
+    bool is_set() const { return m_days != NONE; }
+    int32_t days() const { return m_days; }
+    void to_ymd(int& year, int& month, int& day) const;
+
+    // ММДД (например 1231) - порядок дней рождения внутри года
+    int month_day() const;
+
+    // Полных лет на дату today. День рождения 29.02 в невисокосный год наступает 01.03
+    int age_on(const Date& today) const;
+
+    // Через сколько дней ближайший день рождения (0 - сегодня; 29.02 в невисокосный год - 01.03)
+    int days_until_birthday(const Date& today) const;
+
+    // Беззнаковый ключ с тем же порядком (не заданная дата - самая ранняя)
+    uint32_t sort_key() const { return static_cast<uint32_t>(m_days) ^ 0x80000000u; }
+
+    string toString() const;   // "ДД.ММ.ГГГГ" или "" для не заданной
+
+    // номер дня от 01.01.1970 для любого года, месяца 1..12 и дня (без проверок)
+    static int32_t days_from_civil(int year, int month, int day);
+
+    bool operator==(const Date& other) const { return m_days == other.m_days; }
+    bool operator!=(const Date& other) const { return m_days != other.m_days; }
+    bool operator<(const Date& other) const { return m_days < other.m_days; }
+
+private:
+    static const int32_t NONE = INT32_MIN;
+    int32_t m_days = NONE;
+};
+
+#endif // DATE_H
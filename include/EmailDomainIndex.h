@@ -0,0 +1,37 @@
+#ifndef EMAILDOMAININDEX_H
+#define EMAILDOMAININDEX_H
+
+#include <set>
+#include <unordered_map>
+#include <vector>
+#include <string>
+#include <cstddef>
+#include <utility>
+
+using namespace std;
+
+// Индекс по концу email: все адреса хранятся перевёрнутыми ("ur.ynapmoc@vanav") в упорядоченном наборе,
+// поэтому адреса с общим окончанием ("@company.ru", ".ru") идут подряд и находятся
+// двумя двоичными поисками. Число контактов по каждому домену (часть после '@') хранится отдельно.
+// Регистр не учитывается
+class EmailDomainIndex {
+public:
+    // слоты (по возрастанию), у которых email заканчивается на suffix
+    vector<size_t> findSuffix(const string& suffix) const;
+
+    size_t countDomain(const string& domain) const;        // контактов с этим доменом
+    vector<pair<string, size_t>> domainCounts() const;     // все домены, от самых частых
+
+    void insert(const string& email, size_t slot);
+    void erase(const string& email, size_t slot);
+    void clear();
+
+private:
+    set<pair<string, size_t>> m_reversed;          // (перевёрнутый email, слот)
+    unordered_map<string, size_t> m_domainCounts;  // домен -> число контактов
+
+    static string reversed_key(const string& email);
+    static string domain_of(const string& email);
+};
+
+#endif // EMAILDOMAININDEX_H
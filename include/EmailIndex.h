@@ -0,0 +1,41 @@
+#ifndef EMAILINDEX_H
+#define EMAILINDEX_H
+
+#include <string>
+#include <vector>
+#include <cstddef>
+
+using namespace std;
+
+// Индекс по email (первичный ключ): email -> номер слота в хранилище.
+// Хэш-таблица с открытой адресацией и линейным пробированием,
+// удаление сдвигом назад (без "надгробий" в самой таблице)
+class EmailIndex {
+public:
+    static const size_t npos = static_cast<size_t>(-1);
+
+    EmailIndex();
+
+    size_t find(const string& email) const;          // слот или npos
+    bool insert(const string& email, size_t slot);   // false, если такой email уже есть
+    bool erase(const string& email);
+    void clear();
+
+    size_t size() const { return m_size; }
+
+private:
+    struct Entry {
+        string key;
+        size_t slot = 0;
+        size_t hash = 0;
+        bool used = false;
+    };
+
+    vector<Entry> m_table;   // размер всегда степень двойки
+    size_t m_size;
+
+    size_t locate(const string& email, size_t hash) const; // позиция ключа или npos
+    void grow();
+};
+
+#endif // EMAILINDEX_H
@@ -1,5 +1,13 @@
 #pragma once
 #include "IContactRepository.h"
+#include "EmailIndex.h"
+#include "PhoneIndex.h"
+#include "NameIndex.h"
+#include "TextIndex.h"
+#include "EmailDomainIndex.h"
+#include "SortedIndex.h"
+#include "BirthdayIndex.h"
+#include "JsonWriter.h"
 #include <../third_party/json.hpp>
 #include <string>
 #include <vector>
@@ -11,18 +19,84 @@ using json = nlohmann::json;
 class FileRepository : public IContactRepository {
 private:
     string m_filename;
+
+    // Контакты лежат в слотах; удалённый контакт оставляет пустой слот (m_alive = false),
+    // чтобы удаление было O(1) и порядок остальных не менялся
     vector<Contact> m_contacts;
+    vector<bool> m_alive;
+    size_t m_aliveCount = 0;
+    EmailIndex m_emailIndex;   // email -> слот
+    PhoneIndex m_phoneIndex;   // нормализованный номер -> слоты
+    NameIndex m_nameIndex;     // триграммы ФИО -> слоты
+    TextIndex m_textIndex;     // слова всех полей -> слоты (поиск одной строкой)
+    EmailDomainIndex m_emailDomainIndex; // перевёрнутые email -> слоты, число контактов по доменам
+    BirthdayIndex m_birthdayIndex;       // по возрасту и ближайшим дням рождения
+
+    // слоты, упорядоченные по имени, фамилии, email и дате рождения (порядок как в SortField)
+    SortedIndex m_sorted[4] = {
+        {m_contacts, SortField::FirstName}, {m_contacts, SortField::LastName},
+        {m_contacts, SortField::Email}, {m_contacts, SortField::BirthDate}
+    };
+
+    // Журнал изменений: каждая операция дописывается одной строкой в файл рядом со снимком,
+    // а не переписывает весь contacts.json
+    string m_journalFilename;
+    ofstream m_journal;
+    JsonWriter m_journalWriter{m_journal, JsonWriter::Style::Compact};   // одна строка на запись
+    size_t m_journalRecords = 0;
+
+    // после стольких записей журнал сворачивается обратно в снимок
+    static const size_t JOURNAL_CHECKPOINT_THRESHOLD = 256;
 
     void loadFromFile();
-    void saveToFile(const std::string& filename);
+    bool saveToFile(const std::string& filename);   // false - снимок не записан (старый файл не тронут)
+
+    // изменения только в памяти (без записи на диск) - общие для API и для воспроизведения журнала
+    // applyAdd/applyUpdate возвращают слот контакта или EmailIndex::npos (тогда contact не тронут)
+    size_t applyAdd(Contact&& contact);
+    bool applyRemove(const string& email);
+    size_t applyUpdate(Contact&& contact);
+
+    // убирает пустые слоты и перестраивает индекс, когда их становится слишком много
+    void compact();
+
+    // добавить/убрать контакт в слоте из вторичных индексов (телефон, ФИО, полнотекстовый, домен email,
+    // дни рождения, упорядоченные). Убирать нужно до изменения контакта в слоте
+    void indexSlot(size_t slot);
+    void unindexSlot(size_t slot);
+    void rebuildIndexes();
+
+    void replayJournal();
+    void appendJournal(const char* op, const Contact& contact);   // "add" / "update"
+    void appendJournalRemove(const string& email);
+    void finishJournalRecord();   // перевод строки, сброс на диск, свёртка по порогу
 
 public:
     FileRepository(const string& filename);
-    ~FileRepository() = default;
+    ~FileRepository();
 
     bool addContact(const Contact& contact) override; // Эта функция должна переопределять виртуальную функцию из базового класса
     bool removeContact(const string& email) override;
     bool updateContact(const Contact& contact) override;
+    bool addContact(Contact&& contact) override;
+    bool updateContact(Contact&& contact) override;
     Contact getContact(const string& email) const override;
     vector<Contact> getAllContacts() const override;
+    bool replaceAllContacts(const vector<Contact>& contacts) override; // одна атомарная запись снимка; не записан - ничего не меняется
+    bool replaceAllContacts(vector<Contact>&& contacts) override;
+    vector<Contact> findByPhone(const string& number) const override; // через индекс, O(1)
+    vector<Contact> findByPhonePrefix(const string& digits, size_t limit) const override;
+    vector<Contact> searchByName(const string& name, bool transliterate) const override;
+    vector<Contact> fuzzySearch(const string& name, size_t maxErrors, size_t k) const override;
+    vector<Contact> searchText(const string& query, size_t k) const override;
+    vector<Contact> findByEmailSuffix(const string& suffix) const override;
+    size_t countByEmailDomain(const string& domain) const override;
+    vector<pair<string, size_t>> emailDomainCounts() const override;
+    vector<Contact> getSortedContacts(SortField field, bool ascending) const override; // без сортировки
+    vector<Contact> findByAge(int minAge, int maxAge) const override;
+    vector<Contact> upcomingBirthdays(int days) const override;
+
+    // Сворачивает журнал в снимок: атомарно переписывает contacts.json и очищает журнал
+    // false - снимок записать не удалось, журнал сохранён
+    bool checkpoint();
 };
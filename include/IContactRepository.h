@@ -3,10 +3,14 @@
 
 #include <vector>
 #include <string>
+#include <utility>
 #include "Contact.h"
 
 using namespace std;
 
+// Поля, по которым можно получить контакты упорядоченными
+enum class SortField { FirstName, LastName, Email, BirthDate };
+
 class IContactRepository {
 public:
     virtual ~IContactRepository() = default; 
@@ -14,8 +18,58 @@ public:
     virtual bool addContact(const Contact& contact) = 0; // говорит, что метод можно переопределять
     virtual bool removeContact(const string& email) = 0;
     virtual bool updateContact(const Contact& contact) = 0;
+
+    // Версии для временных объектов: хранилище может забрать контакт без копирования.
+    // По умолчанию просто вызывают версии с const&
+    virtual bool addContact(Contact&& contact);
+    virtual bool updateContact(Contact&& contact);
     virtual Contact getContact(const string& email) const = 0;
     virtual vector<Contact> getAllContacts() const = 0;
+
+    // Заменить весь набор контактов разом (например, после сортировки).
+    // По умолчанию - удалить всё и добавить заново по одному;
+    // хранилища, которые умеют сохранять всё за одну запись, переопределяют это
+    virtual bool replaceAllContacts(const vector<Contact>& contacts);
+    virtual bool replaceAllContacts(vector<Contact>&& contacts);
+
+    // Контакты, у которых есть этот номер (в любой записи: +7..., 8..., со скобками).
+    // По умолчанию - перебор всех контактов; хранилища с индексом по телефону переопределяют это
+    virtual vector<Contact> findByPhone(const string& number) const;
+
+    // Не больше limit контактов, у которых номер начинается с этих цифр (поиск по мере набора).
+    // По умолчанию - перебор всех контактов
+    virtual vector<Contact> findByPhonePrefix(const string& digits, size_t limit) const;
+
+    // Контакты, в ФИО которых есть подстрока name (без учёта регистра, ё = е, см. NameIndex::fold).
+    // С transliterate латинский запрос находит кириллические имена и наоборот.
+    // По умолчанию - перебор всех контактов
+    virtual vector<Contact> searchByName(const string& name, bool transliterate) const;
+
+    // Не больше k контактов, в ФИО которых name встречается с не более чем maxErrors опечатками,
+    // от самых близких. По умолчанию - перебор всех контактов
+    virtual vector<Contact> fuzzySearch(const string& name, size_t maxErrors, size_t k) const;
+
+    // Поиск одной строкой по ФИО, адресу и email: не больше k контактов от самых релевантных
+    // (BM25, см. TextIndex). По умолчанию индекс строится заново по всем контактам
+    virtual vector<Contact> searchText(const string& query, size_t k) const;
+
+    // Контакты, у которых email заканчивается на suffix ("@company.ru", ".ru"), без учёта регистра;
+    // число контактов с доменом (часть email после '@') и все домены от самых частых.
+    // По умолчанию - перебор всех контактов
+    virtual vector<Contact> findByEmailSuffix(const string& suffix) const;
+    virtual size_t countByEmailDomain(const string& domain) const;
+    virtual vector<pair<string, size_t>> emailDomainCounts() const;
+
+    // Все контакты, упорядоченные по полю (при равенстве - в порядке добавления;
+    // по убыванию - ровно обратный порядок). Хранилище при этом не меняется.
+    // По умолчанию - копия всех контактов и сортировка
+    virtual vector<Contact> getSortedContacts(SortField field, bool ascending) const;
+
+    // Контакты с возрастом от minAge до maxAge полных лет (от старших к младшим)
+    // и с днём рождения в ближайшие days дней (по порядку наступления, сегодня - тоже).
+    // По умолчанию - перебор всех контактов
+    virtual vector<Contact> findByAge(int minAge, int maxAge) const;
+    virtual vector<Contact> upcomingBirthdays(int days) const;
 };
 
 
@@ -0,0 +1,75 @@
+#ifndef JSONWRITER_H
+#define JSONWRITER_H
+
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+using namespace std;
+
+// Потоковая запись JSON без промежуточного дерева (nlohmann::json).
+// Значения сразу экранируются в собственный буфер, который уходит в поток кусками
+// по BUFFER_SIZE, поэтому памяти нужно столько, сколько занимает буфер, а не весь документ.
+// Вывод побайтно совпадает с nlohmann::json::dump(4) (Style::Indented) и dump() (Style::Compact),
+// если ключи объекта передаются в алфавитном порядке (так их хранит nlohmann::json).
+// Невалидный UTF-8 заменяется на U+FFFD, как у dump с error_handler_t::replace.
+// Порядок вызовов не проверяется: key - только внутри объекта и перед каждым значением
+class JsonWriter {
+public:
+    enum class Style {
+        Indented,   // отступ 4 пробела, как dump(4)
+        Compact     // без пробелов и переводов строк, как dump()
+    };
+
+    static const size_t BUFFER_SIZE = 64 * 1024;
+
+    explicit JsonWriter(ostream& out, Style style = Style::Indented);
+    ~JsonWriter();   // дописывает буфер в поток
+
+    JsonWriter(const JsonWriter&) = delete;
+    JsonWriter& operator=(const JsonWriter&) = delete;
+
+    void begin_object();
+    void end_object();
+    void begin_array();
+    void end_array();
+
+    void key(string_view name);
+    void value(string_view text);
+    void value(const char* text) { value(string_view(text)); }
+    void value(int64_t number);
+
+    // отдать накопленное в поток (сам поток не сбрасывается)
+    void flush();
+
+private:
+    ostream& m_out;
+    Style m_style;
+    vector<char> m_buffer;
+    size_t m_used = 0;
+
+    // по уровню вложенности: есть ли уже элементы в открытом объекте/массиве
+    vector<bool> m_hasItems;
+    bool m_afterKey = false;
+
+    // гарантировать, что в буфере есть место под count байт (count <= BUFFER_SIZE)
+    void reserve(size_t count) {
+        if (m_used + count > m_buffer.size()) flush();
+    }
+    void put(char c) {
+        reserve(1);
+        m_buffer[m_used++] = c;
+    }
+    void put(const char* data, size_t count);
+
+    void newline_and_indent(size_t depth);
+    void before_value();     // запятая и отступ перед элементом
+    void open(char bracket);
+    void close(char bracket);
+    void write_string(string_view text);
+};
+
+#endif // JSONWRITER_H
@@ -0,0 +1,93 @@
+#ifndef LOG_H
+#define LOG_H
+
+#include <string>
+#include <sstream>
+#include <atomic>
+#include <cstddef>
+
+using namespace std;
+
+// Уровни сообщений. Числа - для препроцессора (LOG_MIN_LEVEL)
+#define LOG_LEVEL_DEBUG   0
+#define LOG_LEVEL_INFO    1
+#define LOG_LEVEL_WARNING 2
+#define LOG_LEVEL_ERROR   3
+#define LOG_LEVEL_NONE    4
+
+// Сообщения ниже этого уровня не попадают в программу вовсе: макрос превращается в пустой
+// оператор, аргументы не вычисляются. Меняется при сборке, например -DLOG_MIN_LEVEL=LOG_LEVEL_DEBUG
+#ifndef LOG_MIN_LEVEL
+#define LOG_MIN_LEVEL LOG_LEVEL_INFO
+#endif
+
+enum class LogLevel {
+    Debug   = LOG_LEVEL_DEBUG,
+    Info    = LOG_LEVEL_INFO,
+    Warning = LOG_LEVEL_WARNING,   // Warning и Error печатаются в stderr, остальные - в stdout
+    Error   = LOG_LEVEL_ERROR,
+    None    = LOG_LEVEL_NONE
+};
+
+// Журнал диагностических сообщений.
+// write не печатает сам: сообщение кладётся в кольцевой буфер без блокировок (несколько
+// пишущих потоков занимают ячейки атомарной операцией), а печатает его отдельный поток.
+// Только если буфер переполнен, пишущий сам печатает накопленное - сообщения не теряются.
+// Пока уровень выключен, сообщение даже не собирается в строку
+class Log {
+public:
+    static bool enabled(LogLevel level) {
+        return static_cast<int>(level) >= s_level.load(memory_order_relaxed);
+    }
+
+    // уровень во время работы (не ниже LOG_MIN_LEVEL - то, что вырезано при сборке, не вернуть)
+    static void set_level(LogLevel level);
+    static LogLevel level() { return static_cast<LogLevel>(s_level.load(memory_order_relaxed)); }
+
+    // положить сообщение в буфер (перевод строки добавляется при печати)
+    static void write(LogLevel level, const string& message);
+
+    // напечатать всё, что уже в буфере, прямо сейчас (например, перед аварийным выходом).
+    // Журнал - только для диагностики: вопросы и ответы пользователю печатает интерфейс напрямую
+    static void flush();
+
+private:
+    inline static atomic<int> s_level{LOG_MIN_LEVEL};
+};
+
+#define LOG_AT(level, message)                                \
+    do {                                                      \
+        if (Log::enabled(level)) {                            \
+            ostringstream log_stream_;                        \
+            log_stream_ << message;                           \
+            Log::write(level, log_stream_.str());             \
+        }                                                     \
+    } while (0)
+
+#define LOG_STRIPPED(message) do {} while (0)
+
+#if LOG_MIN_LEVEL <= LOG_LEVEL_DEBUG
+#define LOG_DEBUG(message) LOG_AT(LogLevel::Debug, message)
+#else
+#define LOG_DEBUG(message) LOG_STRIPPED(message)
+#endif
+
+#if LOG_MIN_LEVEL <= LOG_LEVEL_INFO
+#define LOG_INFO(message) LOG_AT(LogLevel::Info, message)
+#else
+#define LOG_INFO(message) LOG_STRIPPED(message)
+#endif
+
+#if LOG_MIN_LEVEL <= LOG_LEVEL_WARNING
+#define LOG_WARNING(message) LOG_AT(LogLevel::Warning, message)
+#else
+#define LOG_WARNING(message) LOG_STRIPPED(message)
+#endif
+
+#if LOG_MIN_LEVEL <= LOG_LEVEL_ERROR
+#define LOG_ERROR(message) LOG_AT(LogLevel::Error, message)
+#else
+#define LOG_ERROR(message) LOG_STRIPPED(message)
+#endif
+
+#endif // LOG_H
@@ -0,0 +1,81 @@
+#pragma once
+#include "IContactRepository.h"
+#include <string>
+#include <string_view>
+#include <optional>
+#include <cstdint>
+
+using namespace std;
+
+// Контакт прямо из отображённого в память снимка: поля - string_view на байты файла,
+// ничего не копируется, пока не попросят Contact целиком
+class ContactView {
+private:
+    const char* m_data;   // начало отображения
+    size_t m_size;
+    size_t m_record;      // смещение записи
+
+    string_view field(int index) const;
+    size_t phonesOffset() const;
+
+public:
+    ContactView(const char* data, size_t size, size_t record)
+        : m_data(data), m_size(size), m_record(record) {}
+
+    string_view firstName() const  { return field(0); }
+    string_view lastName() const   { return field(1); }
+    string_view patronymic() const { return field(2); }
+    string_view address() const    { return field(3); }
+    string_view birthDate() const  { return field(4); }
+    string_view email() const      { return field(5); }
+
+    int phoneCount() const;
+    PhoneNumber phone(int index) const;   // номер собирается из упакованных цифр
+
+    Contact toContact() const;
+};
+
+// Хранилище только для чтения поверх снимка BinaryRepository, отображённого в память (mmap).
+// Открытие не зависит от размера книги, страницы файла разделяются между процессами через кэш ОС.
+// Изменяющие операции не поддерживаются и возвращают false.
+class MappedRepository : public IContactRepository {
+private:
+    string m_filename;
+    const char* m_data = nullptr;
+    size_t m_size = 0;
+    uint32_t m_count = 0;
+
+#ifdef _WIN32
+    void* m_file = nullptr;
+    void* m_mapping = nullptr;
+#endif
+
+    bool map();
+    void unmap();
+    size_t recordOffset(uint32_t index) const;
+
+public:
+    MappedRepository(const string& filename);
+    ~MappedRepository();
+
+    MappedRepository(const MappedRepository&) = delete;
+    MappedRepository& operator=(const MappedRepository&) = delete;
+
+    bool is_open() const { return m_data != nullptr; }
+
+    // Доступ без копирования
+    size_t size() const { return m_count; }
+    ContactView at(size_t index) const;
+    optional<ContactView> find(string_view email) const;  // двоичный поиск по таблице email
+
+    using IContactRepository::addContact;      // версии для временных объектов - из базового класса
+    using IContactRepository::updateContact;
+    using IContactRepository::replaceAllContacts;
+
+    bool addContact(const Contact& contact) override;
+    bool removeContact(const string& email) override;
+    bool updateContact(const Contact& contact) override;
+    Contact getContact(const string& email) const override;
+    vector<Contact> getAllContacts() const override;
+    bool replaceAllContacts(const vector<Contact>& contacts) override;
+};
@@ -0,0 +1,81 @@
+#ifndef NAMEINDEX_H
+#define NAMEINDEX_H
+
+#include "Contact.h"
+#include <unordered_map>
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <cstddef>
+#include <utility>
+
+using namespace std;
+
+// Триграммный индекс для поиска по подстроке в ФИО.
+// Для каждого слота хранится ключ поиска - "имя фамилия отчество", приведённый fold,
+// и его транслитерация латиницей. Для каждой тройки подряд идущих байт ключей -
+// отсортированный список слотов, где она встречается.
+// Запрос длиной от трёх байт ищется пересечением списков его троек,
+// и только оставшиеся кандидаты проверяются поиском подстроки.
+// Удалённый слот в списках только помечается (частые тройки есть почти у всех ключей,
+// и сдвиг списка делал бы каждое удаление O(N)); обновление оживляет пометки на месте,
+// а список сжимается, когда удалённых в нём становится больше живых
+class NameIndex {
+public:
+    // ключ поиска для контакта и приведение запроса к тому же виду
+    static string key_of(const Contact& contact);
+
+    // Приведение UTF-8 строки к одному регистру: латиница и кириллица (включая Latin-1)
+    // в нижний регистр, ё -> е. Остальные символы не меняются
+    static string fold(const string& text);
+
+    // Транслитерация уже приведённой fold строки: кириллица -> латиница (ж -> zh, ш -> sh, ...)
+    static string transliterate(const string& folded);
+
+    // Слоты (по возрастанию), в ключе которых есть подстрока query (query уже приведён fold).
+    // С translit ищет ещё и транслитерацию запроса в транслитерации ключа,
+    // так что "ivanov" находит "Иванов", а "Иванов" - "Ivanov"
+    vector<size_t> search(const string& query, bool translit = false) const;
+
+    // Нечёткий поиск: не больше k слотов, в ключе которых query встречается с не более чем
+    // maxErrors правками (вставка, удаление, замена символа). Результат - пары (слот, число правок),
+    // от самых близких. Кандидаты сначала отбираются по числу общих троек, потом считается
+    // расстояние битово-параллельным алгоритмом Майерса
+    vector<pair<size_t, size_t>> fuzzy(const string& query, size_t maxErrors, size_t k) const;
+
+    // Наименьшее число правок, за которое query (уже приведённый fold) становится подстрокой text.
+    // Считается по символам UTF-8, а не по байтам
+    static size_t fuzzy_distance(const string& query, const string& text);
+
+    void insert(size_t slot, const Contact& contact);
+    void erase(size_t slot);
+    void clear();
+
+private:
+    vector<string> m_keys;      // ключ поиска по слоту
+    vector<string> m_translit;  // транслитерация ключа (пустая, если совпадает с ключом)
+    vector<bool> m_used;        // есть ли контакт в слоте
+    vector<uint64_t> m_signature; // какие символы есть в ключе (бит = хэш символа), для нечёткого поиска
+    struct PostingList {
+        vector<size_t> entries;  // (слот << 1) | 1 - живая запись, (слот << 1) - удалённая; по возрастанию
+        size_t dead = 0;         // удалённых среди entries
+        size_t alive() const { return entries.size() - dead; }
+        bool contains(size_t slot) const;
+    };
+    unordered_map<uint32_t, PostingList> m_postings; // тройка байт -> слоты по возрастанию
+
+    static uint32_t trigram(const string& text, size_t pos);
+    static uint64_t signature(const string& text);
+    void addPostings(const string& key, size_t slot);
+    void removePostings(const string& key, size_t slot);
+    static void compact(PostingList& list);   // выбрасывает удалённые записи, когда их слишком много
+
+    const string& translitKey(size_t slot) const {
+        return m_translit[slot].empty() ? m_keys[slot] : m_translit[slot];
+    }
+
+    // слоты, у которых в ключе (или в транслитерации) есть подстрока query
+    vector<size_t> searchIn(const string& query, bool inTranslit) const;
+};
+
+#endif // NAMEINDEX_H
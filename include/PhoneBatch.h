@@ -0,0 +1,51 @@
+#ifndef PHONEBATCH_H
+#define PHONEBATCH_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+using namespace std;
+
+// Пакетная проверка и нормализация телефонов для массового импорта.
+// Номера лежат столбцом: все строки подряд в одном буфере data, номер i - байты
+// [offsets[i], offsets[i + 1]). Для каждого номера за один проход:
+// - убираются разделители (пробелы, дефисы, скобки, плюсы) и пробелы по краям,
+// - проверяется, что остались только цифры и их ровно 11,
+// - проверяется код: +7... или 8..., 8 заменяется на 7,
+// - пишется ключ нормализованного номера и бит валидности.
+// Результат совпадает с Validators::validate_phone и PhoneNumber::key_of.
+// Символы классифицируются сравнениями по 16 байт, цифры собираются в число перестановкой
+// (pshufb) и попарными умножениями-сложениями. Ядра: SSSE3 и AVX2 (два номера за раз);
+// лучшее выбирается при первом вызове по возможностям процессора, иначе - обычный цикл
+class PhoneBatch {
+public:
+    enum class Kernel {
+        Scalar,
+        SSSE3,
+        AVX2
+    };
+
+    // Лучшее ядро, доступное на этом процессоре
+    static Kernel best_kernel();
+    static const char* kernel_name(Kernel kernel);
+
+    // keys[i] - PhoneNumber::key_of(номер i) для валидного номера и 0 для невалидного;
+    // бит i % 64 в valid[i / 64] - валиден ли номер (validate_phone).
+    // offsets - count + 1 значений, keys - count, valid - (count + 63) / 64 слов.
+    // Возвращает число валидных номеров
+    static size_t normalize(const char* data, const size_t* offsets, size_t count,
+                            uint64_t* keys, uint64_t* valid);
+    static size_t normalize(const char* data, const size_t* offsets, size_t count,
+                            uint64_t* keys, uint64_t* valid, Kernel kernel);
+
+    // То же для набора строк (строки сначала складываются в столбец)
+    static size_t normalize(const vector<string>& numbers, vector<uint64_t>& keys, vector<uint64_t>& valid);
+
+    static bool is_valid(const vector<uint64_t>& valid, size_t index) {
+        return (valid[index / 64] >> (index % 64)) & 1;
+    }
+};
+
+#endif // PHONEBATCH_H
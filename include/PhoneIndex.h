@@ -0,0 +1,46 @@
+#ifndef PHONEINDEX_H
+#define PHONEINDEX_H
+
+#include "PhoneNumber.h"
+#include <unordered_map>
+#include <set>
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <cstddef>
+
+using namespace std;
+
+// Индексы по телефону.
+// 1) Обратный индекс (определитель номера): нормализованный ключ номера
+//    (PhoneNumber::normalized_key) -> слоты контактов, у которых есть этот номер.
+//    Один номер может быть у нескольких контактов, поэтому на ключ хранится список слотов.
+// 2) Упорядоченный индекс для поиска по началу номера (набор с клавиатуры):
+//    номера упорядочены как строки цифр, все номера с заданным началом идут подряд
+class PhoneIndex {
+public:
+    // слоты с этим ключом (пустой список, если таких нет)
+    const vector<size_t>& find(uint64_t key) const;
+
+    // не больше limit разных слотов, у которых нормализованный номер начинается с этих цифр
+    // (в порядке возрастания номера). Ведущая 8 считается кодом России, как в normalized()
+    vector<size_t> findPrefix(const string& digits, size_t limit) const;
+
+    void insert(const PhoneNumber& phone, size_t slot);
+    void erase(const PhoneNumber& phone, size_t slot);
+    void clear();
+
+    size_t size() const { return m_slots.size(); }  // число разных номеров
+
+private:
+    unordered_map<uint64_t, vector<size_t>> m_slots;
+
+    // (ключ порядка, слот). Ключ порядка - первые 15 цифр номера, дополненные нулями справа,
+    // и длина в младших 4 битах: сравнение таких чисел совпадает со сравнением строк цифр
+    set<pair<uint64_t, size_t>> m_ordered;
+
+    static constexpr size_t ORDER_DIGITS = 15;
+    static uint64_t order_key(const string& digits);
+};
+
+#endif // PHONEINDEX_H
@@ -3,12 +3,16 @@
 
 #include <iostream>
 #include <string>
+#include <memory>
+#include <cstdint>
+#include <functional>
+#include "JsonWriter.h"
 #include <../third_party/json.hpp>
 
 using json = nlohmann::json;
 using namespace std;
 
-enum class PhoneType {
+enum class PhoneType : uint8_t {
     Work,      // Рабочий
     Home,      // Домашний
     Mobile     // Служебный
@@ -16,21 +20,37 @@ enum class PhoneType {
 
 class PhoneNumber {
 private:
-    string number;
-    PhoneType type;
+    // Как хранится номер. Для любой записи один раз считается ключ - нормализованный номер числом.
+    // Обычные записи "8XXXXXXXXXX" и "+7XXXXXXXXXX" восстанавливаются из ключа,
+    // любая другая запись (со скобками, дефисами, неполная) хранится ещё и строкой как есть.
+    enum class Format : uint8_t {
+        Plain8,   // 8XXXXXXXXXX
+        Plus7,    // +7XXXXXXXXXX
+        Raw       // строка в raw
+    };
+
+    uint64_t key = 0;             // нормализованный ключ, см. key_of
+    unique_ptr<string> raw;       // только для Format::Raw (nullptr - пустой номер)
+    PhoneType type = PhoneType::Mobile;
+    Format format = Format::Raw;
+
+    void assign(const string& number);
 
 public:
     // Конструкторы
     // Дефолтный конструктор
     PhoneNumber() = default;
     PhoneNumber(const string& number, PhoneType type = PhoneType::Mobile);
-    // конструктор копирования
-    // PhoneNumber(const PhoneNumber &copy);
+    // конструктор копирования (raw копируется глубоко)
+    PhoneNumber(const PhoneNumber& copy);
+    PhoneNumber(PhoneNumber&& other) noexcept = default;
+    PhoneNumber& operator=(const PhoneNumber& copy);
+    PhoneNumber& operator=(PhoneNumber&& other) noexcept = default;
     // деструктор
-    // ~PhoneNumber();
+    ~PhoneNumber() = default;
     
     // Геттеры
-    string get_number() const;
+    string get_number() const;    // исходная запись номера (короткая строка - без выделения памяти)
     PhoneType get_type() const;
     string type_to_string() const;
     
@@ -40,6 +60,14 @@ public:
     
     // Нормализация (все форматы -> +7XXXXXXXXXX)
     string normalized() const;
+
+    // Нормализованный номер одним числом: биты 56-59 - число цифр (до 15), младшие - сами цифры.
+    // Считается один раз при установке номера; равенство, хэш и порядок телефонов - по нему.
+    // Номера длиннее 15 цифр получают ключ с флагом KEY_HASHED (хэш строки), их сравнивают строкой
+    uint64_t normalized_key() const { return key; }
+    static uint64_t key_of(const string& number);   // тот же ключ для произвольной строки (запроса)
+
+    static const uint64_t KEY_HASHED = 1ULL << 60;
     
     // Валидация
     bool is_valid() const;
@@ -49,6 +77,7 @@ public:
     string toJson() const;
     static PhoneNumber fromJson(const string& json);
     json toJsonObj() const;
+    void writeJson(JsonWriter& writer) const;   // сразу в поток, те же байты, что и toJsonObj
     
     // чтобы удобно выводить содержимое объекта в виде строки
     string toString() const;
@@ -56,6 +85,18 @@ public:
     // одинаковые ли телефоны (для поиска и сортировки)
     bool operator==(const PhoneNumber& other) const;
     bool operator!=(const PhoneNumber& other) const;
+    // по ключу; у равных хэшированных ключей - по нормализованной строке, как и в ==
+    bool operator<(const PhoneNumber& other) const;
 };
 
+// чтобы телефоны можно было класть в unordered_set/unordered_map
+namespace std {
+    template <>
+    struct hash<PhoneNumber> {
+        size_t operator()(const PhoneNumber& phone) const noexcept {
+            return hash<uint64_t>()(phone.normalized_key());
+        }
+    };
+}
+
 #endif // PHONENUMBER_H
\ No newline at end of file
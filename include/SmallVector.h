@@ -0,0 +1,177 @@
+#ifndef SMALLVECTOR_H
+#define SMALLVECTOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <utility>
+#include <initializer_list>
+#include <type_traits>
+
+// Вектор с местом под N элементов прямо внутри объекта.
+// Пока элементов не больше N - никаких выделений памяти и всё лежит рядом с владельцем;
+// при переполнении элементы переезжают в обычный буфер в куче.
+template <typename T, size_t N>
+class SmallVector {
+public:
+    using value_type = T;
+    using size_type = size_t;
+    using iterator = T*;
+    using const_iterator = const T*;
+    using reference = T&;
+    using const_reference = const T&;
+
+    SmallVector() = default;
+
+    SmallVector(std::initializer_list<T> items) {
+        reserve(items.size());
+        for (const T& item : items) push_back(item);
+    }
+
+    template <typename It, typename = decltype(*std::declval<It>())>
+    SmallVector(It first, It last) {
+        for (; first != last; ++first) push_back(*first);
+    }
+
+    SmallVector(const SmallVector& other) {
+        reserve(other.m_size);
+        for (const T& item : other) push_back(item);
+    }
+
+    SmallVector(SmallVector&& other) noexcept {
+        takeFrom(other);
+    }
+
+    SmallVector& operator=(const SmallVector& other) {
+        if (this != &other) {
+            clear();
+            reserve(other.m_size);
+            for (const T& item : other) push_back(item);
+        }
+        return *this;
+    }
+
+    SmallVector& operator=(SmallVector&& other) noexcept {
+        if (this != &other) {
+            clear();
+            freeHeap();
+            takeFrom(other);
+        }
+        return *this;
+    }
+
+    ~SmallVector() {
+        clear();
+        freeHeap();
+    }
+
+    // Доступ
+    iterator begin() { return m_data; }
+    iterator end() { return m_data + m_size; }
+    const_iterator begin() const { return m_data; }
+    const_iterator end() const { return m_data + m_size; }
+
+    T& operator[](size_t i) { return m_data[i]; }
+    const T& operator[](size_t i) const { return m_data[i]; }
+    T& front() { return m_data[0]; }
+    const T& front() const { return m_data[0]; }
+    T& back() { return m_data[m_size - 1]; }
+    const T& back() const { return m_data[m_size - 1]; }
+
+    size_t size() const { return m_size; }
+    size_t capacity() const { return m_capacity; }
+    bool empty() const { return m_size == 0; }
+    bool is_inline() const { return m_data == inlineData(); }
+
+    // Изменение
+    void reserve(size_t n) {
+        if (n <= m_capacity) return;
+
+        T* data = static_cast<T*>(::operator new(n * sizeof(T)));
+        for (size_t i = 0; i < m_size; ++i) {
+            new (data + i) T(std::move(m_data[i]));
+            m_data[i].~T();
+        }
+        freeHeap();
+        m_data = data;
+        m_capacity = static_cast<uint32_t>(n);
+    }
+
+    void push_back(const T& item) { emplace_back(item); }
+    void push_back(T&& item) { emplace_back(std::move(item)); }
+
+    template <typename... Args>
+    T& emplace_back(Args&&... args) {
+        if (m_size == m_capacity) {
+            // аргумент может ссылаться на наш же элемент - строим копию до переезда
+            T item(std::forward<Args>(args)...);
+            reserve(m_capacity ? m_capacity * 2 : 1);
+            new (m_data + m_size) T(std::move(item));
+        } else {
+            new (m_data + m_size) T(std::forward<Args>(args)...);
+        }
+        return m_data[m_size++];
+    }
+
+    void pop_back() {
+        m_data[--m_size].~T();
+    }
+
+    iterator erase(const_iterator pos) {
+        T* p = m_data + (pos - m_data);
+        for (T* q = p; q + 1 != end(); ++q) *q = std::move(*(q + 1));
+        pop_back();
+        return p;
+    }
+
+    void clear() {
+        for (size_t i = 0; i < m_size; ++i) m_data[i].~T();
+        m_size = 0;
+    }
+
+    bool operator==(const SmallVector& other) const {
+        if (m_size != other.m_size) return false;
+        for (size_t i = 0; i < m_size; ++i) {
+            if (!(m_data[i] == other.m_data[i])) return false;
+        }
+        return true;
+    }
+
+    bool operator!=(const SmallVector& other) const { return !(*this == other); }
+
+private:
+    T* m_data = inlineData();
+    uint32_t m_size = 0;
+    uint32_t m_capacity = N;
+    alignas(T) unsigned char m_inline[N * sizeof(T)];
+
+    T* inlineData() { return reinterpret_cast<T*>(m_inline); }
+    const T* inlineData() const { return reinterpret_cast<const T*>(m_inline); }
+
+    void freeHeap() {
+        if (!is_inline()) ::operator delete(m_data);
+        m_data = inlineData();
+        m_capacity = N;
+    }
+
+    // other - после вызова пустой и снова на встроенном буфере
+    void takeFrom(SmallVector& other) noexcept {
+        if (other.is_inline()) {
+            for (size_t i = 0; i < other.m_size; ++i) {
+                new (inlineData() + i) T(std::move(other.m_data[i]));
+                other.m_data[i].~T();
+            }
+            m_data = inlineData();
+            m_capacity = N;
+        } else {
+            m_data = other.m_data;
+            m_capacity = other.m_capacity;
+            other.m_data = other.inlineData();
+            other.m_capacity = N;
+        }
+        m_size = other.m_size;
+        other.m_size = 0;
+    }
+};
+
+#endif // SMALLVECTOR_H
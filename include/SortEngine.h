@@ -0,0 +1,49 @@
+#ifndef SORTENGINE_H
+#define SORTENGINE_H
+
+#include "Contact.h"
+#include "IContactRepository.h"
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <cstddef>
+
+using namespace std;
+
+// Сортировка по нескольким полям сразу (например: фамилия по возрастанию, затем имя,
+// затем дата рождения по убыванию).
+// Для каждого контакта один раз строится двоичный ключ сравнения - поля подряд в таком виде,
+// что обычное побайтовое сравнение ключей даёт нужный порядок. Потом ключи сортируются
+// поразрядно (MSD radix) по 8-байтным префиксам, без вызова геттеров при сравнении.
+// Сортировка устойчивая: при равенстве всех полей сохраняется исходный порядок
+class SortEngine {
+public:
+    struct Key {
+        SortField field;
+        bool ascending;
+    };
+
+    // перестановка: order[i] - номер контакта, который должен стоять i-м
+    static vector<size_t> order(const vector<Contact>& contacts, const vector<Key>& keys);
+
+    // переставить контакты на месте
+    static void sort(vector<Contact>& contacts, const vector<Key>& keys);
+
+    // Ключ сравнения одного контакта. Строка: байты, где 0x00 записан как 0x00 0xFF,
+    // и в конце 0x00 0x01 (так "ab" < "abc"); дата - 4 байта Date::sort_key старшим байтом вперёд.
+    // Для поля по убыванию все его байты инвертируются
+    static void append_key(string& out, const Contact& contact, const vector<Key>& keys);
+
+private:
+    struct Item {
+        uint64_t prefix;   // 8 байт ключа, начиная с текущей глубины (старший байт - первый)
+        size_t offset;     // начало ключа в общем буфере
+        uint32_t length;
+        uint32_t index;    // номер контакта
+    };
+
+    static void radix_sort(Item* items, Item* buffer, size_t count, const string& keys, size_t depth, int byte);
+    static void load_prefix(Item& item, const string& keys, size_t depth);
+};
+
+#endif // SORTENGINE_H
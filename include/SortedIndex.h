@@ -0,0 +1,43 @@
+#ifndef SORTEDINDEX_H
+#define SORTEDINDEX_H
+
+#include "Contact.h"
+#include "IContactRepository.h"
+#include <set>
+#include <vector>
+#include <cstddef>
+
+using namespace std;
+
+// Упорядоченный вторичный индекс: слоты хранилища, отсортированные по одному полю
+// (при равенстве - по слоту, то есть в порядке добавления - в обоих направлениях,
+// как у устойчивой сортировки SortEngine).
+// Сравнение читает поля прямо из вектора контактов хранилища, поэтому слот нужно убрать
+// из индекса ДО изменения контакта и вернуть ПОСЛЕ
+class SortedIndex {
+public:
+    struct Less {
+        const vector<Contact>* contacts;
+        SortField field;
+        bool operator()(size_t a, size_t b) const;
+        int compare(size_t a, size_t b) const;   // только по полю: <0, 0, >0
+    };
+    using Slots = set<size_t, Less>;
+
+    SortedIndex(const vector<Contact>& contacts, SortField field)
+        : m_slots(Less{&contacts, field}) {}
+
+    void insert(size_t slot) { m_slots.insert(slot); }
+    void erase(size_t slot) { m_slots.erase(slot); }
+    void clear() { m_slots.clear(); }
+
+    // по возрастанию - прямой обход
+    const Slots& slots() const { return m_slots; }
+    // по убыванию поля; равные по полю - всё так же по возрастанию слота
+    vector<size_t> descending() const;
+
+private:
+    Slots m_slots;
+};
+
+#endif // SORTEDINDEX_H
@@ -0,0 +1,75 @@
+#ifndef TEXTINDEX_H
+#define TEXTINDEX_H
+
+#include "Contact.h"
+#include <unordered_map>
+#include <vector>
+#include <array>
+#include <string>
+#include <cstdint>
+#include <cstddef>
+#include <utility>
+
+using namespace std;
+
+// Полнотекстовый индекс по всем текстовым полям контакта (ФИО, адрес, email) для поиска
+// "одной строкой". Поля режутся на слова (приведённые NameIndex::fold), для каждого слова
+// хранится список слотов по возрастанию с числом вхождений в каждое поле.
+// Удаление не сдвигает список, а только помечает запись (O(log n) на слово): частые слова
+// вроде "com" или "ru" есть почти у всех, и сдвиг делал бы каждое удаление O(N). Повторная
+// вставка того же слота (обновление контакта) оживляет пометку на месте. Помеченные записи
+// выбрасываются одним проходом, когда их становится больше живых, - как FileRepository::compact().
+// Вставка нового слота не в конец списка по-прежнему O(длина списка), но новые контакты
+// получают самый большой слот, а после compact() индекс строится заново по возрастанию.
+// Результаты ранжируются по BM25F: частота слова в поле с весом поля и поправкой на длину поля,
+// редкие слова весят больше. Лучшие k ищутся алгоритмом MaxScore - слоты, которые уже
+// не могут попасть в лучшие k, не досчитываются
+class TextIndex {
+public:
+    enum Field { FirstName, LastName, Patronymic, Address, Email, FIELD_COUNT };
+
+    // слова строки: буквы и цифры (байты UTF-8 вне ASCII считаются буквами), остальное - разделители
+    static vector<string> tokenize(const string& text);
+
+    // лучшие k слотов по убыванию релевантности: пары (слот, оценка)
+    vector<pair<size_t, double>> search(const string& query, size_t k) const;
+
+    void insert(size_t slot, const Contact& contact);
+    void erase(size_t slot);
+    void clear();
+
+private:
+    struct Posting {
+        size_t slot;
+        uint8_t tf[FIELD_COUNT]; // сколько раз слово встречается в каждом поле
+        bool alive;              // false - слот удалён, запись ждёт сжатия списка
+    };
+
+    struct PostingList {
+        vector<Posting> items;   // слоты по возрастанию, вместе с удалёнными
+        size_t dead = 0;         // удалённых среди items
+        size_t alive() const { return items.size() - dead; }
+    };
+
+    unordered_map<string, uint32_t> m_termIds;   // слово -> номер
+    vector<string> m_terms;                      // номер -> слово
+    vector<PostingList> m_postings;              // номер слова -> слоты по возрастанию
+    vector<uint32_t> m_freeTermIds;              // номера слов, которые больше нигде не встречаются
+
+    vector<vector<uint32_t>> m_slotTerms;        // слова слота - чтобы убрать его из списков
+    vector<array<uint16_t, FIELD_COUNT>> m_fieldLength; // длина полей слота в словах
+    vector<bool> m_used;
+    size_t m_count = 0;                          // контактов в индексе
+    size_t m_totalLength[FIELD_COUNT] = {};      // сумма длин полей - для средней длины
+
+    // параметры BM25 и веса полей
+    static constexpr double K1 = 1.2;
+    static constexpr double B = 0.75;
+    static const double FIELD_BOOST[FIELD_COUNT];
+
+    double fieldWeightedTf(const Posting& posting) const; // частота с весами полей и поправкой на длину
+    uint32_t termId(const string& term);
+    static void compact(PostingList& list);   // выбрасывает удалённые записи, когда их слишком много
+};
+
+#endif // TEXTINDEX_H
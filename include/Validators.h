@@ -2,15 +2,14 @@
 #define VALIDATORS_H
 
 #include <string>
-#include <regex>
+#include <string_view>
 #include <ctime>
 
 using namespace std;
 
+// Все проверки - один проход по string_view, без копий строки и выделения памяти
 class Validators {
 public:
-    // Передаем строки по ссылке, чтобы не копировать
-
     /**
     Проверка имени (ФИО)
     
@@ -20,7 +19,7 @@ public:
     - дефис (не в начале и не в конце)
 
      */
-    static bool validate_name(const string& name);    
+    static bool validate_name(string_view name);    
     /**
     Проверка телефона
     
@@ -33,11 +32,18 @@ public:
         8(812)123-45-67
 
      */
-    static bool validate_phone(const string& phone);
-    static bool validate_email(const string& newEmail);
+    static bool validate_phone(string_view phone);
+    /**
+    Проверка email (пробельные символы в любом месте не учитываются)
+
+    Грамматика: [a-zA-Z0-9._%+-]+ @ [a-zA-Z0-9.-]+ . [a-zA-Z]{2,}
+    Разбирается конечным автоматом, таблица переходов строится при компиляции
+
+     */
+    static bool validate_email(string_view newEmail);
 
-    static bool validate_birthDate(const string& birthDate);
-    static bool parse_date(const string& date_str, int& year, int& month, int& day);
+    static bool validate_birthDate(string_view birthDate);
+    static bool parse_date(string_view date_str, int& year, int& month, int& day);
     static int days_in_month(int month, int year);
     static bool is_past_date(int year, int month, int day);
 };
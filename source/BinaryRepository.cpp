@@ -0,0 +1,397 @@
+#include "BinaryRepository.h"
+#include "Log.h"
+#include "JsonWriter.h"
+#include <../third_party/json.hpp>
+#include <iostream>
+#include <fstream>
+#include <filesystem>
+#include <cstring>
+#include <algorithm>
+
+using json = nlohmann::json;
+using namespace std;
+
+const char BinaryRepository::MAGIC[4] = {'P', 'B', 'K', 'B'};
+
+// Запись в буфер
+
+static void putU8(string& out, uint8_t v) {
+    out.push_back(static_cast<char>(v));
+}
+
+static void putU16(string& out, uint16_t v) {
+    for (int i = 0; i < 2; ++i) out.push_back(static_cast<char>((v >> (8 * i)) & 0xFF));
+}
+
+static void putU32(string& out, uint32_t v) {
+    for (int i = 0; i < 4; ++i) out.push_back(static_cast<char>((v >> (8 * i)) & 0xFF));
+}
+
+static void putU64(string& out, uint64_t v) {
+    for (int i = 0; i < 8; ++i) out.push_back(static_cast<char>((v >> (8 * i)) & 0xFF));
+}
+
+static void putString(string& out, const string& s) {
+    putU32(out, static_cast<uint32_t>(s.size()));
+    out.append(s);
+}
+
+static void patchU32(string& out, size_t pos, uint32_t v) {
+    for (int i = 0; i < 4; ++i) out[pos + i] = static_cast<char>((v >> (8 * i)) & 0xFF);
+}
+
+// Последние 10 цифр номера, если он записан ровно как prefix + 10 цифр
+static bool packDigits(const string& number, size_t prefixLen, uint64_t& digits) {
+    if (number.size() != prefixLen + 10) return false;
+    digits = 0;
+    for (size_t i = prefixLen; i < number.size(); ++i) {
+        if (number[i] < '0' || number[i] > '9') return false;
+        digits = digits * 10 + static_cast<uint64_t>(number[i] - '0');
+    }
+    return true;
+}
+
+string BinaryRepository::phoneFromDigits(PhoneFormat format, uint64_t digits) {
+    char buf[16];
+    snprintf(buf, sizeof(buf), "%s%010llu", format == PHONE_PLUS_7 ? "+7" : "8",
+             static_cast<unsigned long long>(digits));
+    return buf;
+}
+
+static void putPhone(string& out, const PhoneNumber& phone) {
+    const string number = phone.get_number();
+    putU8(out, static_cast<uint8_t>(phone.get_type()));
+
+    uint64_t digits;
+    if (number[0] == '8' && packDigits(number, 1, digits)) {
+        putU8(out, BinaryRepository::PHONE_PLAIN_8);
+        putU64(out, digits);
+    } else if (number.compare(0, 2, "+7") == 0 && packDigits(number, 2, digits)) {
+        putU8(out, BinaryRepository::PHONE_PLUS_7);
+        putU64(out, digits);
+    } else {
+        putU8(out, BinaryRepository::PHONE_RAW);
+        putString(out, number);
+    }
+}
+
+static bool readContact(BinaryRepository::Reader& in, Contact& contact) {
+    string firstName, lastName, patronymic, address, birthDate, email;
+    in.str(firstName);
+    in.str(lastName);
+    in.str(patronymic);
+    in.str(address);
+    in.str(birthDate);
+    in.str(email);
+
+    PhoneList phones;
+    size_t phoneCount = static_cast<size_t>(in.uint(2));
+    for (size_t i = 0; i < phoneCount && in.ok; ++i) {
+        PhoneType type = static_cast<PhoneType>(in.uint(1));
+        uint8_t format = static_cast<uint8_t>(in.uint(1));
+
+        string number;
+        switch (format) {
+            case BinaryRepository::PHONE_PLAIN_8:
+            case BinaryRepository::PHONE_PLUS_7:
+                number = BinaryRepository::phoneFromDigits(static_cast<BinaryRepository::PhoneFormat>(format), in.uint(8));
+                break;
+            case BinaryRepository::PHONE_RAW:
+                in.str(number);
+                break;
+            default: in.ok = false; break;
+        }
+        phones.emplace_back(number, type);
+    }
+
+    if (!in.ok) return false;
+
+    contact = Contact(std::move(firstName), std::move(lastName), std::move(patronymic),
+                      std::move(address), std::move(birthDate), std::move(email), std::move(phones));
+    return true;
+}
+
+// Снимок целиком
+
+bool BinaryRepository::writeSnapshot(const string& filename, const vector<Contact>& contacts) {
+    string out;
+    out.append(MAGIC, sizeof(MAGIC));
+    putU16(out, FORMAT_VERSION);
+    putU16(out, 0);
+    putU32(out, static_cast<uint32_t>(contacts.size()));
+
+    // таблица смещений заполняется по мере записи контактов
+    const size_t offsetsPos = out.size();
+    out.append(contacts.size() * 4, '\0');
+
+    // порядок записей по email - для поиска без загрузки контактов (MappedRepository)
+    vector<uint32_t> byEmail(contacts.size());
+    for (size_t i = 0; i < byEmail.size(); ++i) byEmail[i] = static_cast<uint32_t>(i);
+    sort(byEmail.begin(), byEmail.end(), [&](uint32_t a, uint32_t b) {
+        return contacts[a].ref_email() < contacts[b].ref_email();
+    });
+    for (uint32_t index : byEmail) putU32(out, index);
+
+    for (size_t i = 0; i < contacts.size(); ++i) {
+        const Contact& c = contacts[i];
+        patchU32(out, offsetsPos + i * 4, static_cast<uint32_t>(out.size()));
+
+        putString(out, c.ref_firstName());
+        putString(out, c.ref_lastName());
+        putString(out, c.ref_patronymic());
+        putString(out, c.ref_address());
+        putString(out, c.get_birthDate());
+        putString(out, c.ref_email());
+
+        const PhoneList& phones = c.ref_phones();
+        if (phones.size() > MAX_PHONES) {
+            // обрезанный счётчик испортил бы все следующие записи - лучше не писать снимок вовсе
+            LOG_ERROR("[BinaryRepository] Too many phones (" << phones.size() << ") for contact "
+                      << c.ref_email() << ", snapshot is not saved: " << filename);
+            return false;
+        }
+        putU16(out, static_cast<uint16_t>(phones.size()));
+        for (const auto& phone : phones) putPhone(out, phone);
+    }
+
+    // пишем во временный файл и подменяем им старый
+    const string tmpFilename = filename + ".tmp";
+    ofstream file(tmpFilename, ios::binary);
+    if (!file.is_open()) {
+        LOG_ERROR("Cannot open file for writing: " << tmpFilename);
+        return false;
+    }
+    file.write(out.data(), static_cast<streamsize>(out.size()));
+    file.close();
+    if (!file) {
+        LOG_ERROR("Cannot write file: " << tmpFilename);
+        return false;
+    }
+
+    error_code ec;
+    filesystem::rename(tmpFilename, filename, ec);
+    if (ec) {
+        LOG_ERROR("Cannot replace file " << filename << ": " << ec.message());
+        return false;
+    }
+    return true;
+}
+
+bool BinaryRepository::readSnapshot(const string& filename, vector<Contact>& contacts) {
+    contacts.clear();
+
+    ifstream file(filename, ios::binary | ios::ate);
+    if (!file.is_open()) {
+        LOG_WARNING("[BinaryRepository] Could not open file: " << filename);
+        return false;
+    }
+
+    // весь файл одним чтением, дальше разбор из памяти
+    string data(static_cast<size_t>(file.tellg()), '\0');
+    file.seekg(0);
+    file.read(&data[0], static_cast<streamsize>(data.size()));
+    if (!file) {
+        LOG_ERROR("[BinaryRepository] Could not read file: " << filename);
+        return false;
+    }
+
+    if (data.size() < HEADER_SIZE || memcmp(data.data(), MAGIC, sizeof(MAGIC)) != 0) {
+        LOG_ERROR("[BinaryRepository] Not a phonebook snapshot: " << filename);
+        return false;
+    }
+
+    Reader in{data.data(), data.size(), sizeof(MAGIC), true};
+    uint16_t version = static_cast<uint16_t>(in.uint(2));
+    in.uint(2); // флаги
+    uint32_t count = static_cast<uint32_t>(in.uint(4));
+
+    if (version != FORMAT_VERSION) {
+        LOG_ERROR("[BinaryRepository] Unsupported snapshot version: " << version);
+        return false;
+    }
+    if (!in.need(static_cast<size_t>(count) * 4)) {
+        LOG_ERROR("[BinaryRepository] Snapshot is truncated: " << filename);
+        return false;
+    }
+
+    const size_t offsetsPos = in.pos;
+    contacts.resize(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        Reader offset{data.data(), data.size(), offsetsPos + static_cast<size_t>(i) * 4, true};
+        Reader record{data.data(), data.size(), static_cast<size_t>(offset.uint(4)), true};
+        if (record.pos > data.size() || !readContact(record, contacts[i])) {
+            LOG_ERROR("[BinaryRepository] Snapshot record " << i << " is damaged");
+            contacts.clear();
+            return false;
+        }
+    }
+    return true;
+}
+
+// Конвертеры
+
+bool BinaryRepository::importJson(const string& jsonFilename, const string& binaryFilename) {
+    ifstream file(jsonFilename);
+    if (!file.is_open()) {
+        LOG_WARNING("[BinaryRepository] Could not open file: " << jsonFilename);
+        return false;
+    }
+
+    vector<Contact> contacts;
+    string error;
+    bool ok = Contact::readJsonArray(file, [&contacts](Contact& contact) {
+        // как и FileRepository, пропускаем совсем пустые записи
+        if (contact.ref_firstName().empty() && contact.ref_lastName().empty())
+            return;
+        contacts.push_back(std::move(contact));
+    }, error);
+
+    if (!ok) {
+        LOG_ERROR("[BinaryRepository] JSON parse error: " << error);
+        return false;
+    }
+    return writeSnapshot(binaryFilename, contacts);
+}
+
+bool BinaryRepository::exportJson(const string& binaryFilename, const string& jsonFilename) {
+    vector<Contact> contacts;
+    if (!readSnapshot(binaryFilename, contacts)) return false;
+
+    // тот же вид, что пишет FileRepository
+    ofstream file(jsonFilename);
+    if (!file.is_open()) {
+        LOG_ERROR("Cannot open file for writing: " << jsonFilename);
+        return false;
+    }
+    {
+        JsonWriter writer(file);
+        writer.begin_array();
+        for (const auto& contact : contacts) {
+            contact.writeJson(writer);
+        }
+        writer.end_array();
+    }
+    return static_cast<bool>(file);
+}
+
+// Хранилище
+
+BinaryRepository::BinaryRepository(const string& filename)
+    : m_filename(filename)
+{
+    loadFromFile();
+}
+
+bool BinaryRepository::loadFromFile() {
+    if (!readSnapshot(m_filename, m_contacts)) {
+        m_contacts.clear();
+        rebuildIndex();
+        return false;
+    }
+    rebuildIndex();
+    return true;
+}
+
+bool BinaryRepository::saveToFile(const string& filename) const {
+    return writeSnapshot(filename, m_contacts);
+}
+
+void BinaryRepository::rebuildIndex() {
+    m_emailIndex.clear();
+    // как и FileRepository, второй контакт с тем же email пропускаем: найти его по email нельзя
+    size_t kept = 0;
+    for (size_t i = 0; i < m_contacts.size(); ++i) {
+        if (!m_emailIndex.insert(m_contacts[i].ref_email(), kept)) {
+            LOG_WARNING("[BinaryRepository] Duplicate email skipped: " << m_contacts[i].ref_email());
+            continue;
+        }
+        if (kept != i) m_contacts[kept] = std::move(m_contacts[i]);
+        ++kept;
+    }
+    m_contacts.resize(kept);
+}
+
+bool BinaryRepository::addContact(const Contact& contact) {
+    if (m_emailIndex.find(contact.ref_email()) != EmailIndex::npos) return false;
+    return addContact(Contact(contact));
+}
+
+bool BinaryRepository::addContact(Contact&& contact) {
+    if (!m_emailIndex.insert(contact.ref_email(), m_contacts.size())) return false;
+
+    m_contacts.push_back(std::move(contact));
+    if (saveToFile(m_filename)) return true;
+
+    // снимок не записан - в памяти остаётся то же, что в файле
+    m_emailIndex.erase(m_contacts.back().ref_email());
+    m_contacts.pop_back();
+    return false;
+}
+
+bool BinaryRepository::removeContact(const string& email) {
+    size_t pos = m_emailIndex.find(email);
+    if (pos == EmailIndex::npos) return false;
+
+    // снимок всё равно переписывается целиком, поэтому просто удаляем и переиндексируем
+    Contact removed = std::move(m_contacts[pos]);
+    m_contacts.erase(m_contacts.begin() + static_cast<ptrdiff_t>(pos));
+    rebuildIndex();
+    if (saveToFile(m_filename)) return true;
+
+    m_contacts.insert(m_contacts.begin() + static_cast<ptrdiff_t>(pos), std::move(removed));
+    rebuildIndex();
+    return false;
+}
+
+bool BinaryRepository::updateContact(const Contact& contact) {
+    size_t pos = m_emailIndex.find(contact.ref_email());
+    if (pos == EmailIndex::npos) return false;
+
+    return updateContact(Contact(contact));
+}
+
+bool BinaryRepository::updateContact(Contact&& contact) {
+    size_t pos = m_emailIndex.find(contact.ref_email());
+    if (pos == EmailIndex::npos) return false;
+
+    Contact previous = std::move(m_contacts[pos]);
+    m_contacts[pos] = std::move(contact);
+    if (saveToFile(m_filename)) return true;
+
+    m_contacts[pos] = std::move(previous);
+    return false;
+}
+
+Contact BinaryRepository::getContact(const string& email) const {
+    size_t pos = m_emailIndex.find(email);
+    if (pos != EmailIndex::npos) return m_contacts[pos];
+
+    return Contact(); // пустой контакт
+}
+
+vector<Contact> BinaryRepository::getAllContacts() const {
+    return m_contacts;
+}
+
+bool BinaryRepository::replaceAllContacts(const vector<Contact>& contacts) {
+    return replaceAllContacts(vector<Contact>(contacts));
+}
+
+bool BinaryRepository::replaceAllContacts(vector<Contact>&& contacts) {
+    EmailIndex index;
+    for (size_t i = 0; i < contacts.size(); ++i) {
+        if (!index.insert(contacts[i].ref_email(), i)) {
+            LOG_WARNING("[BinaryRepository] Duplicate email in bulk replace: " << contacts[i].ref_email());
+            return false;
+        }
+    }
+
+    // старый набор остаётся в contacts - на случай, если снимок не запишется
+    m_contacts.swap(contacts);
+    swap(m_emailIndex, index);
+    if (saveToFile(m_filename)) return true;
+
+    m_contacts.swap(contacts);
+    swap(m_emailIndex, index);
+    return false;
+}
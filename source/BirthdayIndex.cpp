@@ -0,0 +1,85 @@
+#include "BirthdayIndex.h"
+#include "Validators.h"
+#include <algorithm>
+
+// Последний день не позже year.month.day: 29.02 в невисокосный год -> 28.02
+static int32_t floor_date(int year, int month, int day) {
+    return Date::days_from_civil(year, month, min(day, Validators::days_in_month(month, year)));
+}
+
+vector<size_t> BirthdayIndex::byAge(int minAge, int maxAge, const Date& today) const {
+    vector<size_t> result;
+    if (minAge > maxAge || !today.is_set()) return result;
+
+    int year, month, day;
+    today.to_ymd(year, month, day);
+
+    // возраст >= minAge  <=> родился не позже чем minAge лет назад (этот день включён);
+    // возраст <= maxAge  <=> родился позже чем maxAge + 1 лет назад
+    const int32_t latest = floor_date(year - minAge, month, day);
+    const int32_t earliest = floor_date(year - maxAge - 1, month, day);
+
+    auto from = m_byDate.upper_bound({earliest, SIZE_MAX});
+    auto to = m_byDate.upper_bound({latest, SIZE_MAX});
+    for (auto it = from; it != to; ++it) result.push_back(it->second);
+    return result;
+}
+
+void BirthdayIndex::collectRange(int from, int to, vector<size_t>& result) const {
+    if (from > to) return;
+    auto end = m_byMonthDay.upper_bound({to, SIZE_MAX});
+    for (auto it = m_byMonthDay.lower_bound({from, 0}); it != end; ++it) result.push_back(it->second);
+}
+
+void BirthdayIndex::collectMonthDays(int from, int to, bool withLeapDay, vector<size_t>& result) const {
+    collectRange(from, min(to, 228), result);
+    if (withLeapDay) collectRange(229, 229, result);   // 29.02 или (в невисокосный год) 01.03 - перед 01.03
+    collectRange(max(from, 230), to, result);
+}
+
+vector<size_t> BirthdayIndex::upcoming(int days, const Date& today) const {
+    vector<size_t> result;
+    if (days < 0 || !today.is_set()) return result;
+
+    const int from = today.month_day();
+    const Date last = Date::from_days(today.days() + days);
+    int lastYear, lastMonth, lastDay, todayYear, todayMonth, todayDay;
+    last.to_ymd(lastYear, lastMonth, lastDay);
+    today.to_ymd(todayYear, todayMonth, todayDay);
+
+    // 29.02 считается отдельно, а не по ММДД: в невисокосный год его отмечают 01.03.
+    // Берём ближайший такой день и год, на который он выпадает
+    const int leapDayWait = Date::from_ymd(2000, 2, 29).days_until_birthday(today);
+    const bool leapDay = leapDayWait <= days;
+    int leapDayYear, leapDayMonth, leapDayDay;
+    Date::from_days(today.days() + leapDayWait).to_ymd(leapDayYear, leapDayMonth, leapDayDay);
+
+    if (lastYear == todayYear) {
+        collectMonthDays(from, last.month_day(), leapDay, result);
+        return result;
+    }
+
+    // переход через Новый год: до конца года, потом с 1 января.
+    // Если период длиннее года, второй кусок не доходит до сегодняшнего дня - без повторов
+    collectMonthDays(from, 1231, leapDay && leapDayYear == todayYear, result);
+    int to = lastYear - todayYear > 1 ? from - 1 : min(last.month_day(), from - 1);
+    collectMonthDays(101, to, leapDay && leapDayYear != todayYear, result);
+    return result;
+}
+
+void BirthdayIndex::insert(size_t slot, const Date& birthDate) {
+    if (!birthDate.is_set()) return;
+    m_byDate.insert({birthDate.days(), slot});
+    m_byMonthDay.insert({birthDate.month_day(), slot});
+}
+
+void BirthdayIndex::erase(size_t slot, const Date& birthDate) {
+    if (!birthDate.is_set()) return;
+    m_byDate.erase({birthDate.days(), slot});
+    m_byMonthDay.erase({birthDate.month_day(), slot});
+}
+
+void BirthdayIndex::clear() {
+    m_byDate.clear();
+    m_byMonthDay.clear();
+}
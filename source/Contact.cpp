@@ -1,12 +1,14 @@
 #include "Contact.h"
 #include "PhoneNumber.h"
 #include "Validators.h"
+#include "Log.h"
 #include <iostream>
 #include <algorithm>
 #include <sstream>
 #include <iomanip>
 #include <cstdio>
 #include <cstddef>
+#include <thread>
 #include "../third_party/json.hpp"
 
 using namespace std;
@@ -22,36 +24,26 @@ static string trim(const string& str) {
 }
 
 // конструкторы
-Contact::Contact(const string& firstName,
-            const string& lastName, 
-            const string& patronymic,
-            const string& address,
-            const string& birthDate,
-            const string& email,
-            const list<PhoneNumber> phones)
-    : firstName(firstName),
-      lastName(lastName),
-      patronymic(patronymic),
-      address(address),
-      birthDate(birthDate),
-      email(email),
-      phones(phones)
+Contact::Contact(string firstName,
+            string lastName, 
+            string patronymic,
+            string address,
+            string birthDate,
+            string email,
+            PhoneList phones)
+    : firstName(std::move(firstName)),
+      lastName(std::move(lastName)),
+      patronymic(std::move(patronymic)),
+      address(std::move(address)),
+      email(std::move(email)),
+      phones(std::move(phones))
 {
-    cout << "[Contact] A contact has been created:" << firstName << lastName;
+    assign_birthDate(birthDate);
+    revalidate(FIELD_ALL);
+    LOG_DEBUG("[Contact] A contact has been created: " << this->firstName << " " << this->lastName);
 }
 
-// Деструктор
-Contact::~Contact() = default;
-
-// Конструктор копирования
-Contact::Contact(const Contact& other) 
-    : firstName(other.firstName),
-      lastName(other.lastName),
-      patronymic(other.patronymic),
-      address(other.address),
-      birthDate(other.birthDate),
-      email(other.email),
-      phones(other.phones) {}
+// Деструктор, копирование и перемещение - по умолчанию (в заголовке)
 
 // геттеры
 
@@ -72,14 +64,25 @@ string Contact::get_address() const {
 }
 
 string Contact::get_birthDate() const {
-    return birthDate;
+    return birthDate.is_set() ? birthDate.toString() : birthDateText;
+}
+
+void Contact::assign_birthDate(const string& text) {
+    Date date = Date::parse(text);
+    if (date.is_set() && date.toString() == text) {
+        birthDate = date;
+        birthDateText.clear();
+    } else {
+        birthDate = Date();
+        birthDateText = text;
+    }
 }
 
 string Contact::get_email() const {
     return email;
 }
 
-list<PhoneNumber> Contact::get_phones() const {
+PhoneList Contact::get_phones() const {
     return phones;
 }
 
@@ -96,6 +99,7 @@ bool Contact::set_firstName(const string& newFirstName) {
     }
     
     firstName = input;
+    set_valid(FIELD_FIRST_NAME, true);   // цикл выше пропускает только валидное имя
     return true;
 }
 
@@ -110,6 +114,7 @@ bool Contact::set_lastName(const string& newLastName) {
     }
     
     lastName = input;
+    set_valid(FIELD_LAST_NAME, true);
     return true;
 }
 
@@ -125,6 +130,7 @@ bool Contact::set_patronymic(const string& newPatronymic) {
     }
     
     patronymic = input;
+    set_valid(FIELD_PATRONYMIC, true);
     return true;
 }
 
@@ -142,7 +148,10 @@ bool Contact::set_birthDate(const string& newBirthDate) {
         input = trim(input);
     }
     
-    birthDate = input;
+    // введённая дата уже проверена - храним её в обычном виде "ДД.ММ.ГГГГ"
+    birthDate = Date::parse(input);
+    birthDateText = birthDate.is_set() ? string() : input;
+    set_valid(FIELD_BIRTH_DATE, validate_birthDate(get_birthDate()));
     return true;
 }
 
@@ -175,11 +184,12 @@ bool Contact::set_email(const string& newEmail) {
     }
     
     email = input;
+    set_valid(FIELD_EMAIL, true);
     return true;
 }
 
-bool Contact::set_phones(const list<PhoneNumber>& newPhones) {
-    list<PhoneNumber> input = newPhones;
+bool Contact::set_phones(const PhoneList& newPhones) {
+    PhoneList input = newPhones;
     
     while (true) {
         // Контакт должен иметь хотя бы один номер телефона
@@ -201,6 +211,7 @@ bool Contact::set_phones(const list<PhoneNumber>& newPhones) {
 
         if (allValid) {
             phones = input;
+            set_valid(FIELD_PHONES, true);
             return true;
         }
         
@@ -209,8 +220,8 @@ bool Contact::set_phones(const list<PhoneNumber>& newPhones) {
     }
 }
 
-list<PhoneNumber> Contact::prompt_for_phones() {
-    list<PhoneNumber> phoneList;
+PhoneList Contact::prompt_for_phones() {
+    PhoneList phoneList;
     string input;
     
     cout << "Enter phone numbers (one per line, empty line to finish):\n";
@@ -244,8 +255,9 @@ list<PhoneNumber> Contact::prompt_for_phones() {
 void Contact::addPhone(const PhoneNumber& phone) {
     if (phone.is_valid()) {
         phones.push_back(phone);
+        revalidate(FIELD_PHONES);
     } else {
-        cerr << "[Contact] An attempt to add an invalid phone number" << endl;
+        LOG_WARNING("[Contact] An attempt to add an invalid phone number");
     }
 }
 
@@ -256,15 +268,16 @@ void Contact::removePhone(int index) {
             ++it;
         }
         phones.erase(it);
-        cout << "[Contact] Phone number at index " << index << " removed successfully\n";
+        revalidate(FIELD_PHONES);
+        LOG_INFO("[Contact] Phone number at index " << index << " removed successfully");
     } else {
-        cerr << "[Contact] Incorrect phone number index: " << index 
-             << ". Total phones: " << phones.size() << "\n";
+        LOG_WARNING("[Contact] Incorrect phone number index: " << index << ". Total phones: " << phones.size());
     }
 }
 
 void Contact::clearPhones() {
     phones.clear();
+    set_valid(FIELD_PHONES, false);   // без телефонов контакт невалиден
 }
 
 int Contact::phoneCount() const {
@@ -273,52 +286,83 @@ int Contact::phoneCount() const {
 
 // валидация
 
-bool Contact::is_valid() const {
-    // Проверка обязательных полей
-    if (firstName.empty() || lastName.empty() || email.empty()) {
-        cerr << "[Contact] Required fields (First name, Last name or Email) are missing\n";
-        return false;
-    }
+void Contact::set_valid(uint8_t fields, bool valid) {
+    if (valid) m_valid |= fields;
+    else m_valid &= static_cast<uint8_t>(~fields);
+}
 
-    // Проверка валидации имени и фамилии
-    if (!validate_name(firstName) || !validate_name(lastName)) {
-        cerr << "[Contact] Invalid first or last name\n";
-        return false;
+void Contact::revalidate(uint8_t fields) {
+    if (fields & FIELD_FIRST_NAME)
+        set_valid(FIELD_FIRST_NAME, !firstName.empty() && validate_name(firstName));
+    if (fields & FIELD_LAST_NAME)
+        set_valid(FIELD_LAST_NAME, !lastName.empty() && validate_name(lastName));
+    // отчество может быть пустым, но если не пустое — должно быть валидным
+    if (fields & FIELD_PATRONYMIC)
+        set_valid(FIELD_PATRONYMIC, patronymic.empty() || validate_name(patronymic));
+    if (fields & FIELD_EMAIL)
+        set_valid(FIELD_EMAIL, validate_email(email));
+
+    // должен быть хотя бы один телефон, и все - корректные
+    if (fields & FIELD_PHONES) {
+        bool valid = !phones.empty();
+        for (const auto& phone : phones) {
+            if (!phone.is_valid()) {
+                valid = false;
+                break;
+            }
+        }
+        set_valid(FIELD_PHONES, valid);
     }
 
-    // Проверка отчества (может быть пустым, но если не пустое — должно быть валидным)
-    if (!patronymic.empty() && !validate_name(patronymic)) {
-        cerr << "[Contact] Invalid patronymic\n";
-        return false;
-    }
+    if (fields & FIELD_BIRTH_DATE)
+        set_valid(FIELD_BIRTH_DATE, validate_birthDate(get_birthDate()));
+}
 
-    // Email обязателен и должен быть валидным
-    if (!validate_email(email)) {
-        cerr << "[Contact] Invalid email address\n";
-        return false;
-    }
+string Contact::validation_error() const {
+    const uint8_t valid = m_valid;
+    if (valid == FIELD_ALL) return "";
+
+    // первая ошибка в порядке проверок
+    if (firstName.empty() || lastName.empty() || email.empty())
+        return "Required fields (First name, Last name or Email) are missing";
+    if (!(valid & FIELD_FIRST_NAME) || !(valid & FIELD_LAST_NAME))
+        return "Invalid first or last name";
+    if (!(valid & FIELD_PATRONYMIC))
+        return "Invalid patronymic";
+    if (!(valid & FIELD_EMAIL))
+        return "Invalid email address";
+    if (phones.empty())
+        return "There is not a single phone number";
+    // и для телефонов, и для даты рождения (необязательной, но если задана — валидируем)
+    return "One of the phones is invalid";
+}
 
-    // Должен быть хотя бы один телефон
-    if (phones.empty()) {
-        cerr << "[Contact] There is not a single phone number\n";
-        return false;
-    }
+void Contact::validate() {
+    revalidate(FIELD_ALL);
+}
 
-    // Проверка корректности всех телефонов
-    for (const auto& phone : phones) {
-        if (!phone.is_valid()) {
-            cerr << "[Contact] One of the phones is invalid\n";
-            return false;
-        }
-    }
+void Contact::validate_all(vector<Contact>& contacts) {
+    // на маленьких наборах потоки дороже самой проверки
+    const size_t MIN_CONTACTS_PER_THREAD = 4096;
 
-    // Проверка даты рождения (необязательная, но если задана — валидируем)
-    if (!validate_birthDate(birthDate)) {
-        cerr << "[Contact] One of the phones is invalid\n";
-        return false;
+    size_t threads = thread::hardware_concurrency();
+    threads = min(max<size_t>(threads, 1), contacts.size() / MIN_CONTACTS_PER_THREAD);
+    if (threads <= 1) {
+        for (auto& contact : contacts) contact.validate();
+        return;
     }
 
-    return true;
+    // каждый поток проверяет свой непрерывный кусок - контакты не пересекаются
+    vector<thread> workers;
+    workers.reserve(threads);
+    const size_t chunk = (contacts.size() + threads - 1) / threads;
+    for (size_t begin = 0; begin < contacts.size(); begin += chunk) {
+        const size_t end = min(begin + chunk, contacts.size());
+        workers.emplace_back([&contacts, begin, end]() {
+            for (size_t i = begin; i < end; ++i) contacts[i].validate();
+        });
+    }
+    for (auto& worker : workers) worker.join();
 }
 
 
@@ -344,7 +388,7 @@ json Contact::toJsonObj() const {
     j["lastName"]   = lastName;
     j["patronymic"] = patronymic;
     j["address"]    = address;
-    j["birthDate"]  = birthDate;
+    j["birthDate"]  = get_birthDate();
     j["email"]      = email;
 
     j["phones"] = nlohmann::json::array();
@@ -355,6 +399,30 @@ json Contact::toJsonObj() const {
     return j;
 }
 
+// то же без дерева json: поля пишутся прямо в поток в том порядке, в каком их выводит dump
+void Contact::writeJson(JsonWriter& writer) const {
+    writer.begin_object();
+    writer.key("address");
+    writer.value(address);
+    writer.key("birthDate");
+    writer.value(get_birthDate());
+    writer.key("email");
+    writer.value(email);
+    writer.key("firstName");
+    writer.value(firstName);
+    writer.key("lastName");
+    writer.value(lastName);
+    writer.key("patronymic");
+    writer.value(patronymic);
+    writer.key("phones");
+    writer.begin_array();
+    for (const auto& phone : phones) {
+        phone.writeJson(writer);
+    }
+    writer.end_array();
+    writer.end_object();
+}
+
 string Contact::toJson() const {
     return toJsonObj().dump(); // возвращает корректную JSON-строку
 }
@@ -382,7 +450,7 @@ Contact Contact::fromJson(const string& jsonStr) {
         contact.patronymic = data.value("patronymic", "");
         contact.address    = data.value("address", "");
         contact.email      = data.value("email", "");
-        contact.birthDate  = data.value("birthDate", "");
+        contact.assign_birthDate(data.value("birthDate", ""));
 
         // телефоны
         if (data.contains("phones") && data["phones"].is_array()) {
@@ -394,17 +462,151 @@ Contact Contact::fromJson(const string& jsonStr) {
         }
     }
     catch (const std::exception& e) {
-        cerr << "[Contact::fromJson] JSON parse error: " << e.what() << endl;
+        LOG_ERROR("[Contact::fromJson] JSON parse error: " << e.what());
     }
+    contact.revalidate(FIELD_ALL);   // поля проверяются сразу при загрузке
 
     return contact;
 }
 
+// Потоковая загрузка (SAX)
+
+// Обработчик событий парсера nlohmann: поля контакта заполняются прямо по ходу разбора.
+// Ожидаемая структура: [ {"firstName": "...", ..., "phones": [ {"number": "...", "type": 0} ]} ]
+class ContactSaxReader {
+public:
+    using number_integer_t  = json::number_integer_t;
+    using number_unsigned_t = json::number_unsigned_t;
+    using number_float_t    = json::number_float_t;
+    using string_t          = json::string_t;
+    using binary_t          = json::binary_t;
+
+    ContactSaxReader(const function<void(Contact&)>& onContact)
+        : m_onContact(onContact) {}
+
+    std::string error;
+
+    bool null() { return true; }
+    bool boolean(bool) { return true; }
+    bool number_integer(number_integer_t val) { return number(static_cast<long long>(val)); }
+    bool number_unsigned(number_unsigned_t val) { return number(static_cast<long long>(val)); }
+    bool number_float(number_float_t val, const string_t&) { return number(static_cast<long long>(val)); }
+    bool binary(binary_t&) { return true; }
+
+    bool string(string_t& val) {
+        if (m_skip > 0) return true;
+
+        if (m_level == InContact) {
+            string_t* field = contactField(m_key);
+            if (field) *field = std::move(val);
+            else if (m_key == "birthDate") m_contact.assign_birthDate(val);
+        } else if (m_level == InPhone && m_key == "number") {
+            m_phoneNumber = std::move(val);
+        }
+        return true;
+    }
+
+    bool key(string_t& val) {
+        if (m_skip == 0) m_key = std::move(val);
+        return true;
+    }
+
+    bool start_object(std::size_t) {
+        if (m_skip > 0) { ++m_skip; return true; }
+
+        if (m_level == InArray) {
+            m_contact = Contact();
+            m_level = InContact;
+        } else if (m_level == InPhones) {
+            m_phoneNumber.clear();
+            m_phoneType = 0;
+            m_level = InPhone;
+        } else {
+            ++m_skip; // неизвестный вложенный объект - пропускаем целиком
+        }
+        return true;
+    }
+
+    bool end_object() {
+        if (m_skip > 0) { --m_skip; return true; }
+
+        if (m_level == InPhone) {
+            m_contact.phones.push_back(PhoneNumber(m_phoneNumber, static_cast<PhoneType>(m_phoneType)));
+            m_level = InPhones;
+        } else if (m_level == InContact) {
+            m_contact.revalidate(Contact::FIELD_ALL);   // поля проверяются сразу при загрузке
+            m_onContact(m_contact);
+            m_level = InArray;
+        }
+        return true;
+    }
+
+    bool start_array(std::size_t) {
+        if (m_skip > 0) { ++m_skip; return true; }
+
+        if (m_level == Top) {
+            m_level = InArray;
+        } else if (m_level == InContact && m_key == "phones") {
+            m_level = InPhones;
+        } else {
+            ++m_skip;
+        }
+        return true;
+    }
+
+    bool end_array() {
+        if (m_skip > 0) { --m_skip; return true; }
+
+        if (m_level == InPhones) m_level = InContact;
+        else if (m_level == InArray) m_level = Top;
+        return true;
+    }
+
+    bool parse_error(std::size_t, const std::string&, const nlohmann::detail::exception& ex) {
+        error = ex.what();
+        return false;
+    }
+
+private:
+    enum Level { Top, InArray, InContact, InPhones, InPhone };
+
+    const function<void(Contact&)>& m_onContact;
+    Level m_level = Top;
+    int m_skip = 0;          // глубина пропускаемого поддерева
+    string_t m_key;
+
+    Contact m_contact;
+    string_t m_phoneNumber;
+    int m_phoneType = 0;
+
+    string_t* contactField(const string_t& key) {
+        if (key == "firstName")  return &m_contact.firstName;
+        if (key == "lastName")   return &m_contact.lastName;
+        if (key == "patronymic") return &m_contact.patronymic;
+        if (key == "address")    return &m_contact.address;
+        if (key == "email")      return &m_contact.email;
+        return nullptr;
+    }
+
+    bool number(long long val) {
+        if (m_skip == 0 && m_level == InPhone && m_key == "type")
+            m_phoneType = static_cast<int>(val);
+        return true;
+    }
+};
+
+bool Contact::readJsonArray(istream& in, const function<void(Contact&)>& onContact, string& error) {
+    ContactSaxReader reader(onContact);
+    bool ok = json::sax_parse(in, &reader);
+    if (!ok) error = reader.error;
+    return ok;
+}
+
 // вспомогательные методы
 string Contact::toString() const {
     string result = lastName + " " + firstName + " " + patronymic;
-    if (!birthDate.empty()) {
-        result += ", birthDate: " + birthDate;
+    if (has_birthDate()) {
+        result += ", birthDate: " + get_birthDate();
     }
     
     if (!email.empty()) {
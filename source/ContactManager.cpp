@@ -9,6 +9,10 @@ bool ContactManager::addContact(const Contact& contact) {
     return m_repository->addContact(contact);
 }
 
+bool ContactManager::addContact(Contact&& contact) {
+    return m_repository->addContact(std::move(contact));
+}
+
 bool ContactManager::removeContact(const string& email) {
     return m_repository->removeContact(email);
 }
@@ -17,6 +21,10 @@ bool ContactManager::updateContact(const Contact& contact) {
     return m_repository->updateContact(contact);
 }
 
+bool ContactManager::updateContact(Contact&& contact) {
+    return m_repository->updateContact(std::move(contact));
+}
+
 Contact ContactManager::getContact(const string& email) const {
     return m_repository->getContact(email);
 }
@@ -25,43 +33,65 @@ vector<Contact> ContactManager::getAllContacts() const {
     return m_repository->getAllContacts();
 }
 
-vector<Contact> ContactManager::searchByName(const string& name) const {
-    auto contacts = m_repository->getAllContacts(); // сам понимает какой тип данных
-    vector<Contact> result;
+vector<Contact> ContactManager::getSortedContacts(SortField field, bool ascending) const {
+    return m_repository->getSortedContacts(field, ascending);
+}
 
-    // функция для приведения строки к нижнему регистру
-    auto toLower = [](string s) {
-        transform(s.begin(), s.end(), s.begin(),
-                  [](unsigned char ch){ return tolower(ch); });
-        return s;
-    };
+vector<Contact> ContactManager::getSortedContacts(const vector<SortEngine::Key>& keys) const {
+    // по одному полю порядок уже есть в хранилище
+    if (keys.size() == 1) return m_repository->getSortedContacts(keys[0].field, keys[0].ascending);
 
-    string lowerName = toLower(name);
+    vector<Contact> contacts = m_repository->getAllContacts();
+    if (!keys.empty()) SortEngine::sort(contacts, keys);
+    return contacts;
+}
 
-    copy_if(contacts.begin(), contacts.end(), back_inserter(result),
-        [&](const Contact& c) {
-            string full = c.get_firstName() + " " + c.get_lastName() + " " + c.get_patronymic();
-            return full.find(name) != string::npos;
-        });
+vector<Contact> ContactManager::searchByName(const string& name, bool transliterate) const {
+    // хранилище само решает, как искать (FileRepository - по триграммному индексу)
+    return m_repository->searchByName(name, transliterate);
+}
+
+vector<Contact> ContactManager::fuzzySearch(const string& query, size_t maxErrors, size_t k) const {
+    return m_repository->fuzzySearch(query, maxErrors, k);
+}
+
+vector<Contact> ContactManager::searchText(const string& query, size_t k) const {
+    return m_repository->searchText(query, k);
+}
+
+vector<Contact> ContactManager::findByEmailSuffix(const string& suffix) const {
+    return m_repository->findByEmailSuffix(suffix);
+}
 
-    return result;
+size_t ContactManager::countByEmailDomain(const string& domain) const {
+    return m_repository->countByEmailDomain(domain);
+}
+
+vector<pair<string, size_t>> ContactManager::emailDomainCounts() const {
+    return m_repository->emailDomainCounts();
+}
+
+vector<Contact> ContactManager::findByAge(int minAge, int maxAge) const {
+    return m_repository->findByAge(minAge, maxAge);
+}
+
+vector<Contact> ContactManager::upcomingBirthdays(int days) const {
+    return m_repository->upcomingBirthdays(days);
+}
+
+vector<Contact> ContactManager::findByPhone(const string& number) const {
+    return m_repository->findByPhone(number);
+}
+
+vector<Contact> ContactManager::findByPhonePrefix(const string& digits, size_t limit) const {
+    return m_repository->findByPhonePrefix(digits, limit);
 }
 
 bool ContactManager::updateAllContacts(const vector<Contact>& contacts) {
-    // Получаем текущие контакты
-    auto currentContacts = m_repository->getAllContacts();
-    
-    // Удаляем все контакты
-    for (const auto& contact : currentContacts) {
-        m_repository->removeContact(contact.get_email());
-    }
-    
-    // Добавляем отсортированные контакты
-    for (const auto& contact : contacts) {
-        if (!m_repository->addContact(contact)) {
-            return false;
-        }
-    }
-    
-    return true;
+    // хранилище само решает, как сохранить весь набор (FileRepository - одной записью)
+    return m_repository->replaceAllContacts(contacts);
+}
+
+bool ContactManager::updateAllContacts(vector<Contact>&& contacts) {
+    return m_repository->replaceAllContacts(std::move(contacts));
 }
@@ -0,0 +1,109 @@
+#include "Date.h"
+#include "Validators.h"
+#include <ctime>
+#include <cstdio>
+
+// Перевод между днём от 01.01.1970 и григорианской датой без таблиц:
+// год считается начинающимся 1 марта, тогда 29 февраля - последний день года
+int32_t Date::days_from_civil(int year, int month, int day) {
+    year -= month <= 2;
+    const int era = (year >= 0 ? year : year - 399) / 400;
+    const int yearOfEra = year - era * 400;                                       // 0..399
+    const int dayOfYear = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1; // 0..365
+    const int dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    return era * 146097 + dayOfEra - 719468;
+}
+
+void Date::to_ymd(int& year, int& month, int& day) const {
+    const int32_t z = m_days + 719468;
+    const int era = (z >= 0 ? z : z - 146096) / 146097;
+    const int dayOfEra = z - era * 146097;                                                    // 0..146096
+    const int yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+    const int dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+    const int mp = (5 * dayOfYear + 2) / 153;
+    day = dayOfYear - (153 * mp + 2) / 5 + 1;
+    month = mp < 10 ? mp + 3 : mp - 9;
+    year = yearOfEra + era * 400 + (month <= 2);
+}
+
+Date Date::from_ymd(int year, int month, int day) {
+    if (year < 0 || year > 9999 || month < 1 || month > 12) return Date();
+    if (day < 1 || day > Validators::days_in_month(month, year)) return Date();
+    return from_days(days_from_civil(year, month, day));
+}
+
+Date Date::from_days(int32_t days) {
+    Date date;
+    date.m_days = days;
+    return date;
+}
+
+Date Date::parse(const string& text) {
+    int day, month, year;
+    if (!Validators::parse_date(text, day, month, year)) return Date();
+    return from_ymd(year, month, day);
+}
+
+Date Date::today() {
+    // перевод в местное время дорогой, а проверка даты рождения спрашивает сегодняшнюю дату
+    // для каждого контакта - пока не сменилась секунда, отдаём прошлый результат (у каждого потока свой)
+    thread_local std::time_t cachedTime = -1;
+    thread_local Date cachedDate;
+
+    std::time_t t = std::time(nullptr);
+    if (t != cachedTime) {
+        // не std::localtime: у него общий статический буфер, а даты проверяются и из нескольких потоков
+        std::tm now{};
+#ifdef _WIN32
+        localtime_s(&now, &t);
+#else
+        localtime_r(&t, &now);
+#endif
+        cachedDate = from_ymd(now.tm_year + 1900, now.tm_mon + 1, now.tm_mday);
+        cachedTime = t;
+    }
+    return cachedDate;
+}
+
+int Date::month_day() const {
+    int year, month, day;
+    to_ymd(year, month, day);
+    return month * 100 + day;
+}
+
+int Date::age_on(const Date& today) const {
+    int year, month, day, todayYear, todayMonth, todayDay;
+    to_ymd(year, month, day);
+    today.to_ymd(todayYear, todayMonth, todayDay);
+
+    int age = todayYear - year;
+    if (todayMonth * 100 + todayDay < month * 100 + day) --age; // в этом году ещё не было
+    return age;
+}
+
+int Date::days_until_birthday(const Date& today) const {
+    int year, month, day, todayYear, todayMonth, todayDay;
+    to_ymd(year, month, day);
+    today.to_ymd(todayYear, todayMonth, todayDay);
+
+    // день, в который отмечают в году year: 29.02 в невисокосный год - 01.03
+    auto observed = [&](int year) {
+        return day <= Validators::days_in_month(month, year) ? days_from_civil(year, month, day)
+                                                              : days_from_civil(year, 3, 1);
+    };
+
+    // ближайший год, в котором день рождения ещё впереди (или сегодня)
+    int32_t next = observed(todayYear);
+    if (next < today.m_days) next = observed(todayYear + 1);
+    return next - today.m_days;
+}
+
+string Date::toString() const {
+    if (!is_set()) return "";
+
+    int year, month, day;
+    to_ymd(year, month, day);
+    char buf[16];
+    snprintf(buf, sizeof(buf), "%02d.%02d.%04d", day, month, year);
+    return buf;
+}
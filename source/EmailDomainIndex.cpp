@@ -0,0 +1,72 @@
+#include "EmailDomainIndex.h"
+#include <algorithm>
+
+static char lower_ascii(char c) {
+    return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+}
+
+string EmailDomainIndex::reversed_key(const string& email) {
+    string key(email.rbegin(), email.rend());
+    transform(key.begin(), key.end(), key.begin(), lower_ascii);
+    return key;
+}
+
+string EmailDomainIndex::domain_of(const string& email) {
+    size_t at = email.rfind('@');
+    string domain = at == string::npos ? string() : email.substr(at + 1);
+    transform(domain.begin(), domain.end(), domain.begin(), lower_ascii);
+    return domain;
+}
+
+vector<size_t> EmailDomainIndex::findSuffix(const string& suffix) const {
+    vector<size_t> result;
+    const string prefix = reversed_key(suffix);
+
+    // перевёрнутые адреса, начинающиеся с prefix, лежат в [prefix, следующая за prefix строка)
+    auto from = m_reversed.lower_bound({prefix, 0});
+    auto to = m_reversed.end();
+    string next = prefix;
+    while (!next.empty() && static_cast<unsigned char>(next.back()) == 0xFF) next.pop_back();
+    if (!next.empty()) {
+        next.back() = static_cast<char>(static_cast<unsigned char>(next.back()) + 1);
+        to = m_reversed.lower_bound({next, 0});
+    }
+
+    for (auto it = from; it != to; ++it) result.push_back(it->second);
+    sort(result.begin(), result.end());
+    return result;
+}
+
+size_t EmailDomainIndex::countDomain(const string& domain) const {
+    string key = domain;
+    if (!key.empty() && key[0] == '@') key.erase(0, 1);
+    transform(key.begin(), key.end(), key.begin(), lower_ascii);
+
+    auto it = m_domainCounts.find(key);
+    return it == m_domainCounts.end() ? 0 : it->second;
+}
+
+vector<pair<string, size_t>> EmailDomainIndex::domainCounts() const {
+    vector<pair<string, size_t>> result(m_domainCounts.begin(), m_domainCounts.end());
+    sort(result.begin(), result.end(), [](const pair<string, size_t>& a, const pair<string, size_t>& b) {
+        return a.second != b.second ? a.second > b.second : a.first < b.first;
+    });
+    return result;
+}
+
+void EmailDomainIndex::insert(const string& email, size_t slot) {
+    if (m_reversed.insert({reversed_key(email), slot}).second)
+        ++m_domainCounts[domain_of(email)];
+}
+
+void EmailDomainIndex::erase(const string& email, size_t slot) {
+    if (m_reversed.erase({reversed_key(email), slot}) == 0) return;
+
+    auto it = m_domainCounts.find(domain_of(email));
+    if (it != m_domainCounts.end() && --it->second == 0) m_domainCounts.erase(it);
+}
+
+void EmailDomainIndex::clear() {
+    m_reversed.clear();
+    m_domainCounts.clear();
+}
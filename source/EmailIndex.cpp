@@ -0,0 +1,85 @@
+#include "EmailIndex.h"
+#include <functional>
+#include <utility>
+
+using namespace std;
+
+static const size_t INITIAL_CAPACITY = 16;
+
+EmailIndex::EmailIndex()
+    : m_table(INITIAL_CAPACITY), m_size(0) {}
+
+size_t EmailIndex::locate(const string& email, size_t hash) const {
+    const size_t mask = m_table.size() - 1;
+    for (size_t i = hash & mask; m_table[i].used; i = (i + 1) & mask) {
+        if (m_table[i].hash == hash && m_table[i].key == email)
+            return i;
+    }
+    return npos;
+}
+
+size_t EmailIndex::find(const string& email) const {
+    size_t pos = locate(email, std::hash<string>()(email));
+    return pos == npos ? npos : m_table[pos].slot;
+}
+
+bool EmailIndex::insert(const string& email, size_t slot) {
+    const size_t hash = std::hash<string>()(email);
+    if (locate(email, hash) != npos) return false;
+
+    // держим заполненность не выше 70%, иначе цепочки пробирования растут
+    if ((m_size + 1) * 10 > m_table.size() * 7) grow();
+
+    const size_t mask = m_table.size() - 1;
+    size_t i = hash & mask;
+    while (m_table[i].used) i = (i + 1) & mask;
+
+    m_table[i].key = email;
+    m_table[i].slot = slot;
+    m_table[i].hash = hash;
+    m_table[i].used = true;
+    ++m_size;
+    return true;
+}
+
+bool EmailIndex::erase(const string& email) {
+    size_t hole = locate(email, std::hash<string>()(email));
+    if (hole == npos) return false;
+
+    // Сдвигаем назад элементы цепочки, которые могут занять освободившееся место,
+    // чтобы поиск не обрывался на дырке
+    const size_t mask = m_table.size() - 1;
+    for (size_t j = (hole + 1) & mask; m_table[j].used; j = (j + 1) & mask) {
+        size_t home = m_table[j].hash & mask;
+        // home циклически НЕ лежит в (hole, j] - значит элемент можно перенести в hole
+        bool between = (hole <= j) ? (hole < home && home <= j)
+                                   : (hole < home || home <= j);
+        if (!between) {
+            m_table[hole] = std::move(m_table[j]);
+            hole = j;
+        }
+    }
+
+    m_table[hole].key.clear();
+    m_table[hole].used = false;
+    --m_size;
+    return true;
+}
+
+void EmailIndex::clear() {
+    m_table.assign(INITIAL_CAPACITY, Entry());
+    m_size = 0;
+}
+
+void EmailIndex::grow() {
+    vector<Entry> old(m_table.size() * 2);
+    old.swap(m_table);
+
+    const size_t mask = m_table.size() - 1;
+    for (auto& e : old) {
+        if (!e.used) continue;
+        size_t i = e.hash & mask;
+        while (m_table[i].used) i = (i + 1) & mask;
+        m_table[i] = std::move(e);
+    }
+}
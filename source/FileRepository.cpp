@@ -1,52 +1,87 @@
 #include "FileRepository.h"
+#include "Log.h"
 #include <algorithm>
 #include <iostream>
+#include <filesystem>
 
 using json = nlohmann::json;
 using namespace std;
 
 FileRepository::FileRepository(const string& filename)
-    : m_filename(filename)
+    : m_filename(filename),
+      m_journalFilename(filename + ".journal")
 {
     loadFromFile();
+    replayJournal();
+
+    // дальше только дописываем в конец
+    m_journal.open(m_journalFilename, ios::app);
+    if (!m_journal.is_open()) {
+        LOG_ERROR("[FileRepository] Could not open journal: " << m_journalFilename);
+    }
+
+    if (m_journalRecords >= JOURNAL_CHECKPOINT_THRESHOLD) {
+        checkpoint();
+    }
+}
+
+FileRepository::~FileRepository() {
+    // при выходе сворачиваем журнал, чтобы следующий запуск читал только снимок
+    if (m_journalRecords > 0) {
+        checkpoint();
+    }
 }
 
 void FileRepository::loadFromFile() {
-    const string filename = "contacts.json"; 
+    const string& filename = m_filename;
     m_contacts.clear();
+    m_alive.clear();
+    m_aliveCount = 0;
+    m_emailIndex.clear();
+    m_phoneIndex.clear();
+    m_nameIndex.clear();
+    m_textIndex.clear();
+    m_emailDomainIndex.clear();
+    m_birthdayIndex.clear();
+    for (auto& index : m_sorted) index.clear();
 
     ifstream file(filename);
     if (!file.is_open()) {
-        cerr << "[FileRepository] Could not open file: " << filename << "\n";
+        LOG_WARNING("[FileRepository] Could not open file: " << filename);
         return;
     }
 
-    try {
-        // Читаем весь файл как JSON массив
-        json jArray;
-        file >> jArray;
-
-        for (const auto& jContact : jArray) {
-            // Конвертируем JSON объект в строку для обработки
-            string contactStr = jContact.dump();
-            Contact contact = Contact::fromJson(contactStr);
+    // Читаем файл потоково: каждый контакт собирается сразу по ходу разбора
+    string error;
+    bool ok = Contact::readJsonArray(file, [this](Contact& contact) {
+        // Если контакт реально пустой — не добавляем
+        if (contact.ref_firstName().empty() && contact.ref_lastName().empty())
+            return;
 
-            // Если контакт реально пустой — не добавляем
-            if (contact.get_firstName().empty() && contact.get_lastName().empty())
-                continue;
-
-            m_contacts.push_back(contact);
+        if (applyAdd(std::move(contact)) == EmailIndex::npos) {
+            LOG_WARNING("[FileRepository] Duplicate email skipped: " << contact.ref_email());
         }
+    }, error);
 
-        // if (m_contacts.empty())
-        //     cout << "No contacts found.\n";
-        // else
-        //     cout << "[FileRepository] Loaded " << m_contacts.size() << " contacts.\n";
+    // if (m_contacts.empty())
+    //     cout << "No contacts found.\n";
+    // else
+    //     cout << "[FileRepository] Loaded " << m_contacts.size() << " contacts.\n";
 
-    } catch (const json::parse_error& e) {
-        cerr << "[FileRepository] JSON parse error: " << e.what() << "\n";
-        cerr << "File might be empty or corrupted. Creating new file.\n";
+    if (!ok) {
+        LOG_ERROR("[FileRepository] JSON parse error: " << error);
+        LOG_WARNING("File might be empty or corrupted. Creating new file.");
         // Создаем пустой массив
+        m_contacts.clear();
+        m_alive.clear();
+        m_aliveCount = 0;
+        m_emailIndex.clear();
+        m_phoneIndex.clear();
+        m_nameIndex.clear();
+        m_textIndex.clear();
+        m_emailDomainIndex.clear();
+        m_birthdayIndex.clear();
+        for (auto& index : m_sorted) index.clear();
         saveToFile(filename);
     }
 
@@ -54,62 +89,397 @@ void FileRepository::loadFromFile() {
 }
 
 
-void FileRepository::saveToFile(const string& filename) {
-    json jArray = json::array();
-    for (const auto& contact : m_contacts) {
-        jArray.push_back(contact.toJsonObj());
+bool FileRepository::saveToFile(const string& filename) {
+    // пишем во временный файл и подменяем им старый, чтобы при сбое не остаться с обрезанным снимком
+    const string tmpFilename = filename + ".tmp";
+    ofstream file(tmpFilename);
+    if (!file.is_open()) {
+        LOG_ERROR("Cannot open file for writing: " << tmpFilename);
+        return false;
     }
 
-    ofstream file(filename);
-    if (!file.is_open()) {
-        cerr << "Cannot open file for writing: " << filename << "\n";
+    {
+        // контакты пишутся в поток по одному, с отступами как у dump(4), без дерева json
+        // и без строки на весь файл - памяти нужно на буфер JsonWriter, а не на всю книжку
+        JsonWriter writer(file);
+        writer.begin_array();
+        for (size_t slot = 0; slot < m_contacts.size(); ++slot) {
+            if (m_alive[slot]) m_contacts[slot].writeJson(writer);
+        }
+        writer.end_array();
+    }
+    file.close();
+    if (!file) {
+        LOG_ERROR("Cannot write file: " << tmpFilename);
+        return false;
+    }
+
+    error_code ec;
+    filesystem::rename(tmpFilename, filename, ec);
+    if (ec) {
+        LOG_ERROR("Cannot replace file " << filename << ": " << ec.message());
+        return false;
+    }
+    return true;
+}
+
+// Журнал
+
+// Формат журнала - по одной компактной JSON-записи на строку:
+// {"op":"add","contact":{...}}, {"op":"update","contact":{...}}, {"op":"remove","email":"..."}
+void FileRepository::replayJournal() {
+    m_journalRecords = 0;
+
+    ifstream journal(m_journalFilename);
+    if (!journal.is_open()) return; // журнала нет - все изменения уже в снимке
+
+    string line;
+    while (getline(journal, line)) {
+        if (line.empty()) continue;
+
+        json record;
+        try {
+            record = json::parse(line);
+        } catch (const json::parse_error& e) {
+            // недописанная последняя строка (например, программа упала во время записи)
+            LOG_ERROR("[FileRepository] Journal record is damaged, the rest is ignored: " << e.what());
+            break;
+        }
+
+        const string op = record.value("op", "");
+        if (op == "remove") {
+            applyRemove(record.value("email", ""));
+        } else if (op == "add" || op == "update") {
+            if (!record.contains("contact")) continue;
+            Contact contact = Contact::fromJson(record["contact"].dump());
+            if (op == "add") applyAdd(std::move(contact));
+            else applyUpdate(std::move(contact));
+        } else {
+            LOG_WARNING("[FileRepository] Unknown journal operation: " << op);
+            continue;
+        }
+        ++m_journalRecords;
+    }
+}
+
+// Записи пишутся тем же JsonWriter, что и снимок, ключи по алфавиту - как выводил dump()
+void FileRepository::appendJournal(const char* op, const Contact& contact) {
+    if (!m_journal.is_open()) {
+        // без журнала сохраняем по-старому, целиком
+        saveToFile(m_filename);
         return;
     }
 
-    file << jArray.dump(4); // красиво с отступами
-    file.close();
+    m_journalWriter.begin_object();
+    m_journalWriter.key("contact");
+    contact.writeJson(m_journalWriter);
+    m_journalWriter.key("op");
+    m_journalWriter.value(op);
+    m_journalWriter.end_object();
+    finishJournalRecord();
+}
+
+void FileRepository::appendJournalRemove(const string& email) {
+    if (!m_journal.is_open()) {
+        saveToFile(m_filename);
+        return;
+    }
+
+    m_journalWriter.begin_object();
+    m_journalWriter.key("email");
+    m_journalWriter.value(email);
+    m_journalWriter.key("op");
+    m_journalWriter.value("remove");
+    m_journalWriter.end_object();
+    finishJournalRecord();
+}
+
+void FileRepository::finishJournalRecord() {
+    m_journalWriter.flush();
+    m_journal << '\n';
+    m_journal.flush();
+    ++m_journalRecords;
+
+    if (m_journalRecords >= JOURNAL_CHECKPOINT_THRESHOLD) {
+        checkpoint();
+    }
+}
+
+bool FileRepository::checkpoint() {
+    // снимок не записан - журнал остаётся как есть, иначе изменения из него потеряются.
+    // Счётчик тоже не сбрасывается: следующая запись в журнал попробует свернуть его снова
+    if (!saveToFile(m_filename)) return false;
+
+    // снимок уже содержит все изменения - журнал можно обнулить.
+    // Если упадём между этими шагами, повторное воспроизведение журнала ничего не испортит:
+    // add существующего, remove отсутствующего и update на то же значение - пустые операции
+    m_journal.close();
+    m_journal.open(m_journalFilename, ios::trunc);
+    m_journal.close();
+    m_journal.open(m_journalFilename, ios::app);
+    m_journalRecords = 0;
+    return true;
+}
+
+// Изменения в памяти
+
+size_t FileRepository::applyAdd(Contact&& contact) {
+    if (!m_emailIndex.insert(contact.ref_email(), m_contacts.size())) return EmailIndex::npos;
+
+    m_contacts.push_back(std::move(contact));
+    m_alive.push_back(true);
+    ++m_aliveCount;
+    indexSlot(m_contacts.size() - 1);
+    return m_contacts.size() - 1;
+}
+
+bool FileRepository::applyRemove(const string& email) {
+    size_t slot = m_emailIndex.find(email);
+    if (slot == EmailIndex::npos) return false;
+
+    m_emailIndex.erase(email);
+    unindexSlot(slot);
+    m_contacts[slot] = Contact(); // освобождаем память, слот остаётся пустым
+    m_alive[slot] = false;
+    --m_aliveCount;
+
+    compact();
+    return true;
+}
+
+size_t FileRepository::applyUpdate(Contact&& contact) {
+    size_t slot = m_emailIndex.find(contact.ref_email());
+    if (slot == EmailIndex::npos) return EmailIndex::npos;
+
+    unindexSlot(slot);
+    m_contacts[slot] = std::move(contact);
+    indexSlot(slot);
+    return slot;
+}
+
+void FileRepository::compact() {
+    size_t dead = m_contacts.size() - m_aliveCount;
+    if (dead < 32 || dead < m_aliveCount) return; // пустых слотов пока немного
+
+    vector<Contact> contacts;
+    contacts.reserve(m_aliveCount);
+    for (size_t slot = 0; slot < m_contacts.size(); ++slot) {
+        if (m_alive[slot]) contacts.push_back(std::move(m_contacts[slot]));
+    }
+
+    m_contacts.swap(contacts);
+    m_alive.assign(m_contacts.size(), true);
+    m_emailIndex.clear();
+    for (size_t slot = 0; slot < m_contacts.size(); ++slot) {
+        m_emailIndex.insert(m_contacts[slot].ref_email(), slot);
+    }
+    rebuildIndexes();
+}
+
+void FileRepository::indexSlot(size_t slot) {
+    for (const auto& phone : m_contacts[slot].ref_phones()) {
+        m_phoneIndex.insert(phone, slot);
+    }
+    m_nameIndex.insert(slot, m_contacts[slot]);
+    m_textIndex.insert(slot, m_contacts[slot]);
+    m_emailDomainIndex.insert(m_contacts[slot].ref_email(), slot);
+    m_birthdayIndex.insert(slot, m_contacts[slot].ref_birthDate());
+    for (auto& index : m_sorted) index.insert(slot);
 }
 
+void FileRepository::unindexSlot(size_t slot) {
+    for (const auto& phone : m_contacts[slot].ref_phones()) {
+        m_phoneIndex.erase(phone, slot);
+    }
+    m_nameIndex.erase(slot);
+    m_textIndex.erase(slot);
+    m_emailDomainIndex.erase(m_contacts[slot].ref_email(), slot);
+    m_birthdayIndex.erase(slot, m_contacts[slot].ref_birthDate());
+    for (auto& index : m_sorted) index.erase(slot);
+}
+
+void FileRepository::rebuildIndexes() {
+    m_phoneIndex.clear();
+    m_nameIndex.clear();
+    m_textIndex.clear();
+    m_emailDomainIndex.clear();
+    m_birthdayIndex.clear();
+    for (auto& index : m_sorted) index.clear();
+    for (size_t slot = 0; slot < m_contacts.size(); ++slot) {
+        if (m_alive[slot]) indexSlot(slot);
+    }
+}
 
 bool FileRepository::addContact(const Contact& contact) {
-    auto it = find_if(m_contacts.begin(), m_contacts.end(),
-                           [&](const Contact& c){ return c.get_email() == contact.get_email(); });
-    if (it != m_contacts.end()) return false;
+    if (m_emailIndex.find(contact.ref_email()) != EmailIndex::npos) return false;
+    return addContact(Contact(contact));
+}
 
-    m_contacts.push_back(contact);
-    saveToFile("contacts.json");
+bool FileRepository::addContact(Contact&& contact) {
+    size_t slot = applyAdd(std::move(contact));
+    if (slot == EmailIndex::npos) return false;
+
+    appendJournal("add", m_contacts[slot]);
     return true;
 }
 
 bool FileRepository::removeContact(const string& email) {
-    auto it = remove_if(m_contacts.begin(), m_contacts.end(),
-                             [&](const Contact& c){ return c.get_email() == email; });
-    if (it == m_contacts.end()) return false;
+    if (!applyRemove(email)) return false;
 
-    m_contacts.erase(it, m_contacts.end());
-    saveToFile("contacts.json");
+    appendJournalRemove(email);
     return true;
 }
 
 bool FileRepository::updateContact(const Contact& contact) {
-    auto it = find_if(m_contacts.begin(), m_contacts.end(),
-                           [&](const Contact& c){ return c.get_email() == contact.get_email(); });
-    if (it == m_contacts.end()) return false;
+    if (m_emailIndex.find(contact.ref_email()) == EmailIndex::npos) return false;
+    return updateContact(Contact(contact));
+}
+
+bool FileRepository::updateContact(Contact&& contact) {
+    size_t slot = applyUpdate(std::move(contact));
+    if (slot == EmailIndex::npos) return false;
 
-    *it = contact;
-    saveToFile("contacts.json");
+    appendJournal("update", m_contacts[slot]);
+    return true;
+}
+
+bool FileRepository::replaceAllContacts(const vector<Contact>& contacts) {
+    return replaceAllContacts(vector<Contact>(contacts));
+}
+
+bool FileRepository::replaceAllContacts(vector<Contact>&& contacts) {
+    // сначала строим новый индекс - при повторяющемся email ничего не меняем
+    EmailIndex index;
+    for (size_t slot = 0; slot < contacts.size(); ++slot) {
+        if (!index.insert(contacts[slot].ref_email(), slot)) {
+            LOG_WARNING("[FileRepository] Duplicate email in bulk replace: " << contacts[slot].ref_email());
+            return false;
+        }
+    }
+
+    // весь набор сохраняется одной записью снимка, журнал обнуляется. Снимок пишется из слотов,
+    // поэтому новый набор ставится на место старого, а если записать не удалось - возвращается
+    // обратно: в памяти остаётся то же, что на диске (прежний снимок и журнал)
+    vector<bool> alive(contacts.size(), true);
+    size_t aliveCount = contacts.size();
+    m_contacts.swap(contacts);
+    m_alive.swap(alive);
+    swap(m_aliveCount, aliveCount);
+    if (!checkpoint()) {
+        m_contacts.swap(contacts);
+        m_alive.swap(alive);
+        swap(m_aliveCount, aliveCount);
+        return false;
+    }
+
+    m_emailIndex = std::move(index);
+    rebuildIndexes();
     return true;
 }
 
 Contact FileRepository::getContact(const string& email) const {
-    auto it = find_if(m_contacts.begin(), m_contacts.end(),
-                           [&](const Contact& c){ return c.get_email() == email; });
-    if (it != m_contacts.end()) return *it;
+    size_t slot = m_emailIndex.find(email);
+    if (slot != EmailIndex::npos) return m_contacts[slot];
 
     return Contact(); // пустой контакт
 }
 
+vector<Contact> FileRepository::findByPhone(const string& number) const {
+    PhoneNumber query(number);
+    vector<Contact> result;
+
+    for (size_t slot : m_phoneIndex.find(query.normalized_key())) {
+        // для очень длинных номеров ключ - хэш, поэтому сверяем сам номер
+        const PhoneList& phones = m_contacts[slot].ref_phones();
+        if (find(phones.begin(), phones.end(), query) != phones.end())
+            result.push_back(m_contacts[slot]);
+    }
+    return result;
+}
+
+vector<Contact> FileRepository::findByPhonePrefix(const string& digits, size_t limit) const {
+    vector<Contact> result;
+    for (size_t slot : m_phoneIndex.findPrefix(digits, limit)) {
+        result.push_back(m_contacts[slot]);
+    }
+    return result;
+}
+
+vector<Contact> FileRepository::searchByName(const string& name, bool transliterate) const {
+    vector<Contact> result;
+    for (size_t slot : m_nameIndex.search(NameIndex::fold(name), transliterate)) {
+        result.push_back(m_contacts[slot]);
+    }
+    return result;
+}
+
+vector<Contact> FileRepository::fuzzySearch(const string& name, size_t maxErrors, size_t k) const {
+    vector<Contact> result;
+    for (const auto& found : m_nameIndex.fuzzy(NameIndex::fold(name), maxErrors, k)) {
+        result.push_back(m_contacts[found.first]);
+    }
+    return result;
+}
+
+vector<Contact> FileRepository::searchText(const string& query, size_t k) const {
+    vector<Contact> result;
+    for (const auto& found : m_textIndex.search(query, k)) {
+        result.push_back(m_contacts[found.first]);
+    }
+    return result;
+}
+
+vector<Contact> FileRepository::findByEmailSuffix(const string& suffix) const {
+    vector<Contact> result;
+    for (size_t slot : m_emailDomainIndex.findSuffix(suffix)) {
+        result.push_back(m_contacts[slot]);
+    }
+    return result;
+}
+
+size_t FileRepository::countByEmailDomain(const string& domain) const {
+    return m_emailDomainIndex.countDomain(domain);
+}
+
+vector<pair<string, size_t>> FileRepository::emailDomainCounts() const {
+    return m_emailDomainIndex.domainCounts();
+}
+
+vector<Contact> FileRepository::getSortedContacts(SortField field, bool ascending) const {
+    const SortedIndex& index = m_sorted[static_cast<int>(field)];
+
+    vector<Contact> result;
+    result.reserve(index.slots().size());
+    if (ascending) {
+        for (size_t slot : index.slots()) result.push_back(m_contacts[slot]);
+    } else {
+        for (size_t slot : index.descending()) result.push_back(m_contacts[slot]);
+    }
+    return result;
+}
+
+vector<Contact> FileRepository::findByAge(int minAge, int maxAge) const {
+    vector<Contact> result;
+    for (size_t slot : m_birthdayIndex.byAge(minAge, maxAge, Date::today())) {
+        result.push_back(m_contacts[slot]);
+    }
+    return result;
+}
+
+vector<Contact> FileRepository::upcomingBirthdays(int days) const {
+    vector<Contact> result;
+    for (size_t slot : m_birthdayIndex.upcoming(days, Date::today())) {
+        result.push_back(m_contacts[slot]);
+    }
+    return result;
+}
+
 vector<Contact> FileRepository::getAllContacts() const {
-    return m_contacts;
+    vector<Contact> result;
+    result.reserve(m_aliveCount);
+    for (size_t slot = 0; slot < m_contacts.size(); ++slot) {
+        if (m_alive[slot]) result.push_back(m_contacts[slot]);
+    }
+    return result;
 }
 
@@ -0,0 +1,222 @@
+#include "IContactRepository.h"
+#include "NameIndex.h"
+#include "TextIndex.h"
+#include <map>
+#include <tuple>
+#include <algorithm>
+
+// Реализации по умолчанию для хранилищ, которые не переопределяют эти методы
+
+bool IContactRepository::addContact(Contact&& contact) {
+    return addContact(static_cast<const Contact&>(contact));
+}
+
+bool IContactRepository::updateContact(Contact&& contact) {
+    return updateContact(static_cast<const Contact&>(contact));
+}
+
+bool IContactRepository::replaceAllContacts(vector<Contact>&& contacts) {
+    return replaceAllContacts(static_cast<const vector<Contact>&>(contacts));
+}
+
+vector<Contact> IContactRepository::findByPhone(const string& number) const {
+    PhoneNumber query(number);
+    vector<Contact> result;
+    if (query.normalized_key() == 0) return result;
+
+    for (auto& contact : getAllContacts()) {
+        for (const auto& phone : contact.ref_phones()) {
+            if (phone == query) {
+                result.push_back(std::move(contact));
+                break;
+            }
+        }
+    }
+    return result;
+}
+
+vector<Contact> IContactRepository::findByPhonePrefix(const string& digits, size_t limit) const {
+    vector<Contact> result;
+
+    // начало номера приводим так же, как normalized(): только цифры, 8 -> 7
+    string prefix;
+    for (char c : digits) {
+        if (c >= '0' && c <= '9') prefix += c;
+    }
+    if (prefix.empty()) return result;
+    if (prefix[0] == '8') prefix[0] = '7';
+
+    for (auto& contact : getAllContacts()) {
+        if (result.size() >= limit) break;
+        for (const auto& phone : contact.ref_phones()) {
+            if (phone.normalized().compare(0, prefix.size(), prefix) == 0) {
+                result.push_back(std::move(contact));
+                break;
+            }
+        }
+    }
+    return result;
+}
+
+vector<Contact> IContactRepository::searchByName(const string& name, bool transliterate) const {
+    const string query = NameIndex::fold(name);
+    const string translitQuery = NameIndex::transliterate(query);
+    vector<Contact> result;
+
+    for (auto& contact : getAllContacts()) {
+        const string key = NameIndex::key_of(contact);
+        if (key.find(query) != string::npos
+            || (transliterate && NameIndex::transliterate(key).find(translitQuery) != string::npos))
+            result.push_back(std::move(contact));
+    }
+    return result;
+}
+
+vector<Contact> IContactRepository::fuzzySearch(const string& name, size_t maxErrors, size_t k) const {
+    const string query = NameIndex::fold(name);
+
+    // (число опечаток, порядковый номер) - при равенстве сохраняем исходный порядок
+    vector<Contact> contacts = getAllContacts();
+    vector<pair<size_t, size_t>> found;
+    for (size_t i = 0; i < contacts.size(); ++i) {
+        size_t distance = NameIndex::fuzzy_distance(query, NameIndex::key_of(contacts[i]));
+        if (distance <= maxErrors) found.push_back({distance, i});
+    }
+    sort(found.begin(), found.end());
+
+    vector<Contact> result;
+    for (size_t i = 0; i < found.size() && i < k; ++i) {
+        result.push_back(std::move(contacts[found[i].second]));
+    }
+    return result;
+}
+
+vector<Contact> IContactRepository::searchText(const string& query, size_t k) const {
+    vector<Contact> contacts = getAllContacts();
+    TextIndex index;
+    for (size_t i = 0; i < contacts.size(); ++i) {
+        index.insert(i, contacts[i]);
+    }
+
+    vector<Contact> result;
+    for (const auto& found : index.search(query, k)) {
+        result.push_back(std::move(contacts[found.first]));
+    }
+    return result;
+}
+
+// email в нижнем регистре (только латиница - адреса в ASCII)
+static string lower_email(const string& email) {
+    string result(email);
+    for (char& c : result) {
+        if (c >= 'A' && c <= 'Z') c = static_cast<char>(c - 'A' + 'a');
+    }
+    return result;
+}
+
+vector<Contact> IContactRepository::findByEmailSuffix(const string& suffix) const {
+    const string end = lower_email(suffix);
+    vector<Contact> result;
+
+    for (auto& contact : getAllContacts()) {
+        const string email = lower_email(contact.ref_email());
+        if (email.size() >= end.size() && email.compare(email.size() - end.size(), end.size(), end) == 0)
+            result.push_back(std::move(contact));
+    }
+    return result;
+}
+
+size_t IContactRepository::countByEmailDomain(const string& domain) const {
+    string end = lower_email(domain);
+    if (end.empty() || end[0] != '@') end.insert(0, 1, '@');
+    return findByEmailSuffix(end).size();
+}
+
+vector<pair<string, size_t>> IContactRepository::emailDomainCounts() const {
+    map<string, size_t> counts;
+    for (const auto& contact : getAllContacts()) {
+        const string& email = contact.ref_email();
+        size_t at = email.rfind('@');
+        ++counts[at == string::npos ? string() : lower_email(email.substr(at + 1))];
+    }
+
+    vector<pair<string, size_t>> result(counts.begin(), counts.end());
+    stable_sort(result.begin(), result.end(), [](const pair<string, size_t>& a, const pair<string, size_t>& b) {
+        return a.second > b.second;
+    });
+    return result;
+}
+
+vector<Contact> IContactRepository::getSortedContacts(SortField field, bool ascending) const {
+    vector<Contact> contacts = getAllContacts();
+
+    auto less = [field](const Contact& a, const Contact& b) {
+        switch (field) {
+            case SortField::FirstName: return a.ref_firstName() < b.ref_firstName();
+            case SortField::LastName:  return a.ref_lastName() < b.ref_lastName();
+            case SortField::Email:     return a.ref_email() < b.ref_email();
+            case SortField::BirthDate: return a.ref_birthDate() < b.ref_birthDate();
+        }
+        return false;
+    };
+    // равные остаются в порядке хранилища и при сортировке по убыванию (как у SortEngine)
+    if (ascending) stable_sort(contacts.begin(), contacts.end(), less);
+    else stable_sort(contacts.begin(), contacts.end(), [&less](const Contact& a, const Contact& b) { return less(b, a); });
+    return contacts;
+}
+
+vector<Contact> IContactRepository::findByAge(int minAge, int maxAge) const {
+    const Date today = Date::today();
+    vector<Contact> result;
+
+    for (auto& contact : getAllContacts()) {
+        const Date& birthDate = contact.ref_birthDate();
+        if (!birthDate.is_set()) continue;
+
+        int age = birthDate.age_on(today);
+        if (age >= minAge && age <= maxAge) result.push_back(std::move(contact));
+    }
+    stable_sort(result.begin(), result.end(), [](const Contact& a, const Contact& b) {
+        return a.ref_birthDate() < b.ref_birthDate();
+    });
+    return result;
+}
+
+vector<Contact> IContactRepository::upcomingBirthdays(int days) const {
+    const Date today = Date::today();
+
+    // (через сколько дней, ММДД, порядковый номер)
+    vector<Contact> contacts = getAllContacts();
+    vector<tuple<int, int, size_t>> found;
+    for (size_t i = 0; i < contacts.size(); ++i) {
+        const Date& birthDate = contacts[i].ref_birthDate();
+        if (!birthDate.is_set()) continue;
+
+        int until = birthDate.days_until_birthday(today);
+        if (until <= days) found.emplace_back(until, birthDate.month_day(), i);
+    }
+    sort(found.begin(), found.end());
+
+    vector<Contact> result;
+    for (const auto& entry : found) result.push_back(std::move(contacts[get<2>(entry)]));
+    return result;
+}
+
+bool IContactRepository::replaceAllContacts(const vector<Contact>& contacts) {
+    // Получаем текущие контакты
+    auto currentContacts = getAllContacts();
+
+    // Удаляем все контакты
+    for (const auto& contact : currentContacts) {
+        removeContact(contact.ref_email());
+    }
+
+    // Добавляем новые контакты
+    for (const auto& contact : contacts) {
+        if (!addContact(contact)) {
+            return false;
+        }
+    }
+
+    return true;
+}
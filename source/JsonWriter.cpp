@@ -0,0 +1,210 @@
+#include "JsonWriter.h"
+#include <cstring>
+#include <charconv>
+
+using namespace std;
+
+namespace {
+
+const char HEX_DIGITS[] = "0123456789abcdef";
+const char REPLACEMENT_CHARACTER[] = "\xEF\xBF\xBD";   // U+FFFD в UTF-8
+
+// Байт, который можно копировать как есть: печатный ASCII, кроме кавычки и обратной косой черты
+inline bool is_plain(unsigned char c) {
+    return c >= 0x20 && c < 0x80 && c != '"' && c != '\\';
+}
+
+// Длина правильной последовательности UTF-8, начинающейся с text[i] (байт >= 0x80).
+// 0 - последовательность неправильная; тогда в bad - сколько байт заменить одним U+FFFD:
+// неверный первый байт съедается, а неподходящий байт продолжения читается заново
+// (так же разбирает nlohmann::json с error_handler_t::replace)
+size_t utf8_sequence(string_view text, size_t i, size_t& bad) {
+    const unsigned char lead = static_cast<unsigned char>(text[i]);
+    size_t length;
+    unsigned char low = 0x80, high = 0xBF;   // допустимые значения второго байта
+    if (lead >= 0xC2 && lead <= 0xDF) {
+        length = 2;
+    } else if (lead >= 0xE0 && lead <= 0xEF) {
+        length = 3;
+        if (lead == 0xE0) low = 0xA0;        // без избыточной записи
+        if (lead == 0xED) high = 0x9F;       // без суррогатов
+    } else if (lead >= 0xF0 && lead <= 0xF4) {
+        length = 4;
+        if (lead == 0xF0) low = 0x90;
+        if (lead == 0xF4) high = 0x8F;       // не больше U+10FFFF
+    } else {
+        bad = 1;
+        return 0;
+    }
+
+    for (size_t k = 1; k < length; ++k) {
+        if (i + k >= text.size()) {
+            bad = text.size() - i;           // строка оборвалась посреди символа
+            return 0;
+        }
+        const unsigned char c = static_cast<unsigned char>(text[i + k]);
+        if (c < low || c > high) {
+            bad = k;
+            return 0;
+        }
+        low = 0x80;
+        high = 0xBF;
+    }
+    return length;
+}
+
+} // namespace
+
+JsonWriter::JsonWriter(ostream& out, Style style)
+    : m_out(out),
+      m_style(style),
+      m_buffer(BUFFER_SIZE)
+{
+}
+
+JsonWriter::~JsonWriter() {
+    flush();
+}
+
+void JsonWriter::flush() {
+    if (m_used == 0) return;
+    m_out.write(m_buffer.data(), static_cast<streamsize>(m_used));
+    m_used = 0;
+}
+
+void JsonWriter::put(const char* data, size_t count) {
+    if (m_used + count > m_buffer.size()) {
+        flush();
+        if (count >= m_buffer.size()) {
+            // длинный кусок идёт в поток напрямую, мимо буфера
+            m_out.write(data, static_cast<streamsize>(count));
+            return;
+        }
+    }
+    memcpy(m_buffer.data() + m_used, data, count);
+    m_used += count;
+}
+
+void JsonWriter::newline_and_indent(size_t depth) {
+    static const char SPACES[] = "                                                                ";
+    const size_t SPACES_COUNT = sizeof(SPACES) - 1;
+
+    put('\n');
+    size_t count = depth * 4;
+    while (count > 0) {
+        const size_t chunk = count < SPACES_COUNT ? count : SPACES_COUNT;
+        put(SPACES, chunk);
+        count -= chunk;
+    }
+}
+
+void JsonWriter::before_value() {
+    if (m_afterKey) {
+        // значение поля объекта: запятая и отступ уже поставлены перед ключом
+        m_afterKey = false;
+        return;
+    }
+    if (m_hasItems.empty()) return;   // значение верхнего уровня
+
+    // элемент массива
+    if (m_hasItems.back()) put(',');
+    if (m_style == Style::Indented) newline_and_indent(m_hasItems.size());
+    m_hasItems.back() = true;
+}
+
+void JsonWriter::open(char bracket) {
+    before_value();
+    put(bracket);
+    m_hasItems.push_back(false);
+}
+
+void JsonWriter::close(char bracket) {
+    const bool hadItems = m_hasItems.back();
+    m_hasItems.pop_back();
+    // пустые объект и массив пишутся как {} и []
+    if (hadItems && m_style == Style::Indented) newline_and_indent(m_hasItems.size());
+    put(bracket);
+}
+
+void JsonWriter::begin_object() { open('{'); }
+void JsonWriter::end_object()   { close('}'); }
+void JsonWriter::begin_array()  { open('['); }
+void JsonWriter::end_array()    { close(']'); }
+
+void JsonWriter::key(string_view name) {
+    if (m_hasItems.back()) put(',');
+    if (m_style == Style::Indented) newline_and_indent(m_hasItems.size());
+    m_hasItems.back() = true;
+
+    write_string(name);
+    put(':');
+    if (m_style == Style::Indented) put(' ');
+    m_afterKey = true;
+}
+
+void JsonWriter::value(string_view text) {
+    before_value();
+    write_string(text);
+}
+
+void JsonWriter::value(int64_t number) {
+    before_value();
+    char digits[24];
+    const auto result = to_chars(digits, digits + sizeof(digits), number);
+    put(digits, static_cast<size_t>(result.ptr - digits));
+}
+
+void JsonWriter::write_string(string_view text) {
+    put('"');
+
+    size_t i = 0;
+    while (i < text.size()) {
+        // обычные символы копируются одним куском
+        size_t end = i;
+        while (end < text.size() && is_plain(static_cast<unsigned char>(text[end]))) ++end;
+        if (end > i) {
+            put(text.data() + i, end - i);
+            i = end;
+            if (i == text.size()) break;
+        }
+
+        const unsigned char c = static_cast<unsigned char>(text[i]);
+        if (c >= 0x80) {
+            size_t bad = 0;
+            const size_t length = utf8_sequence(text, i, bad);
+            if (length > 0) {
+                put(text.data() + i, length);
+                i += length;
+            } else {
+                put(REPLACEMENT_CHARACTER, 3);
+                i += bad;
+            }
+            continue;
+        }
+
+        reserve(6);
+        char* out = m_buffer.data() + m_used;
+        out[0] = '\\';
+        switch (c) {
+            case '"':  out[1] = '"';  m_used += 2; break;
+            case '\\': out[1] = '\\'; m_used += 2; break;
+            case '\b': out[1] = 'b';  m_used += 2; break;
+            case '\t': out[1] = 't';  m_used += 2; break;
+            case '\n': out[1] = 'n';  m_used += 2; break;
+            case '\f': out[1] = 'f';  m_used += 2; break;
+            case '\r': out[1] = 'r';  m_used += 2; break;
+            default:
+                // остальные управляющие символы - \u00XX строчными буквами
+                out[1] = 'u';
+                out[2] = '0';
+                out[3] = '0';
+                out[4] = HEX_DIGITS[c >> 4];
+                out[5] = HEX_DIGITS[c & 0x0F];
+                m_used += 6;
+                break;
+        }
+        ++i;
+    }
+
+    put('"');
+}
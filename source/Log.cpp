@@ -0,0 +1,165 @@
+#include "Log.h"
+#include <cstdio>
+#include <cstring>
+#include <cstdint>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+
+using namespace std;
+
+namespace {
+
+const size_t CAPACITY = 1024;       // ячеек в кольце (степень двойки)
+const size_t MESSAGE_SIZE = 244;    // длиннее - обрезается, ячейка целиком 256 байт
+
+// Ячейка кольца. sequence говорит, чья сейчас очередь:
+// == позиция записи - свободна для неё, == позиция + 1 - заполнена и ждёт печати
+struct Slot {
+    atomic<size_t> sequence;
+    LogLevel level;
+    uint32_t length;
+    char text[MESSAGE_SIZE];
+};
+
+// Кольцевой буфер на много пишущих и одного читающего (ограниченная очередь Вьюкова)
+// и поток, который печатает из него
+class LogSink {
+public:
+    LogSink() {
+        for (size_t i = 0; i < CAPACITY; ++i) m_slots[i].sequence.store(i, memory_order_relaxed);
+    }
+
+    ~LogSink() {
+        m_stopping.store(true);
+        m_wake.notify_one();
+        if (m_flusher.joinable()) m_flusher.join();
+        drain();
+    }
+
+    void push(LogLevel level, const string& message) {
+        call_once(m_started, [this]() { m_flusher = thread(&LogSink::run, this); });
+
+        // занимаем ячейку: сдвигаем позицию записи, если ячейка под ней свободна
+        size_t position = m_enqueue.load(memory_order_relaxed);
+        Slot* slot;
+        for (;;) {
+            slot = &m_slots[position & (CAPACITY - 1)];
+            const size_t sequence = slot->sequence.load(memory_order_acquire);
+            const intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+            if (diff == 0) {
+                if (m_enqueue.compare_exchange_weak(position, position + 1, memory_order_relaxed)) break;
+            } else if (diff < 0) {
+                // кольцо заполнено: печатаем накопленное сами и пробуем снова
+                drain();
+                position = m_enqueue.load(memory_order_relaxed);
+            } else {
+                position = m_enqueue.load(memory_order_relaxed);
+            }
+        }
+
+        size_t length = message.size();
+        if (length > MESSAGE_SIZE) {
+            // обрезаем, не разрывая символ UTF-8, и помечаем многоточием
+            length = MESSAGE_SIZE - 3;
+            while (length > 0 && (static_cast<unsigned char>(message[length]) & 0xC0) == 0x80) --length;
+            memcpy(slot->text, message.data(), length);
+            memcpy(slot->text + length, "...", 3);
+            length += 3;
+        } else {
+            memcpy(slot->text, message.data(), length);
+        }
+        slot->level = level;
+        slot->length = static_cast<uint32_t>(length);
+        slot->sequence.store(position + 1, memory_order_release);
+
+        // будим поток печати, если он ещё не знает о новых сообщениях
+        if (!m_pending.exchange(true, memory_order_acq_rel)) m_wake.notify_one();
+    }
+
+    // напечатать всё, что заполнено
+    void drain() {
+        lock_guard<mutex> lock(m_consumer);
+        bool printed = false;
+        for (;;) {
+            Slot& slot = m_slots[m_dequeue & (CAPACITY - 1)];
+            if (slot.sequence.load(memory_order_acquire) != m_dequeue + 1) break;
+
+            FILE* out = slot.level >= LogLevel::Warning ? stderr : stdout;
+            fwrite(slot.text, 1, slot.length, out);
+            fputc('\n', out);
+            printed = true;
+
+            // ячейка освобождается для записи через круг
+            slot.sequence.store(m_dequeue + CAPACITY, memory_order_release);
+            ++m_dequeue;
+        }
+        if (printed) {
+            fflush(stdout);
+            fflush(stderr);
+        }
+    }
+
+private:
+    Slot m_slots[CAPACITY];
+    atomic<size_t> m_enqueue{0};
+    size_t m_dequeue = 0;            // только под m_consumer
+    mutex m_consumer;                // читают поток печати, flush и писатель при переполнении - по очереди
+
+    once_flag m_started;
+    thread m_flusher;
+    mutex m_wakeMutex;
+    condition_variable m_wake;
+    atomic<bool> m_pending{false};
+    atomic<bool> m_stopping{false};
+
+    void run() {
+        while (!m_stopping.load()) {
+            {
+                // будильник без блокировки у пишущих может потеряться - тогда печатаем по таймауту
+                unique_lock<mutex> lock(m_wakeMutex);
+                m_wake.wait_for(lock, chrono::milliseconds(50), [this]() {
+                    return m_pending.load() || m_stopping.load();
+                });
+            }
+            m_pending.store(false);
+            drain();
+        }
+    }
+};
+
+// Пишущие после уничтожения буфера (из деструкторов других статических объектов)
+// печатают сразу, без него
+atomic<bool> g_sinkDestroyed{false};
+
+struct SinkHolder {
+    LogSink sink;
+    ~SinkHolder() { g_sinkDestroyed.store(true); }
+};
+
+LogSink& sink() {
+    static SinkHolder holder;
+    return holder.sink;
+}
+
+} // namespace
+
+void Log::set_level(LogLevel level) {
+    int value = static_cast<int>(level);
+    if (value < LOG_MIN_LEVEL) value = LOG_MIN_LEVEL;
+    s_level.store(value, memory_order_relaxed);
+}
+
+void Log::write(LogLevel level, const string& message) {
+    if (g_sinkDestroyed.load()) {
+        FILE* out = level >= LogLevel::Warning ? stderr : stdout;
+        fprintf(out, "%s\n", message.c_str());
+        return;
+    }
+    sink().push(level, message);
+}
+
+void Log::flush() {
+    if (!g_sinkDestroyed.load()) sink().drain();
+}
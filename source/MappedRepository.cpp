@@ -0,0 +1,263 @@
+// системные заголовки - до наших, где есть using namespace std (иначе конфликт имени byte в windows.h)
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "MappedRepository.h"
+#include "BinaryRepository.h"
+#include "Log.h"
+#include <iostream>
+#include <cstring>
+
+using namespace std;
+
+using Reader = BinaryRepository::Reader;
+
+// ContactView
+
+string_view ContactView::field(int index) const {
+    Reader in{m_data, m_size, m_record, true};
+    for (int i = 0; i < index; ++i) in.view();
+    return in.view();
+}
+
+size_t ContactView::phonesOffset() const {
+    Reader in{m_data, m_size, m_record, true};
+    for (int i = 0; i < 6; ++i) in.view();
+    return in.ok ? in.pos : m_size;
+}
+
+int ContactView::phoneCount() const {
+    Reader in{m_data, m_size, phonesOffset(), true};
+    return static_cast<int>(in.uint(2));
+}
+
+// Телефон с текущей позиции in. Без build только пропускается - номер не собирается
+static PhoneNumber readPhone(Reader& in, bool build) {
+    PhoneType type = static_cast<PhoneType>(in.uint(1));
+    uint8_t format = static_cast<uint8_t>(in.uint(1));
+
+    if (format == BinaryRepository::PHONE_RAW) {
+        string_view number = in.view();
+        if (build) return PhoneNumber(string(number), type);
+    } else {
+        uint64_t digits = in.uint(8);
+        if (build)
+            return PhoneNumber(BinaryRepository::phoneFromDigits(
+                static_cast<BinaryRepository::PhoneFormat>(format), digits), type);
+    }
+    return PhoneNumber();
+}
+
+PhoneNumber ContactView::phone(int index) const {
+    Reader in{m_data, m_size, phonesOffset(), true};
+    int count = static_cast<int>(in.uint(2));
+    if (index < 0 || index >= count) return PhoneNumber();
+
+    for (int i = 0; i < index && in.ok; ++i) readPhone(in, false);
+    return in.ok ? readPhone(in, true) : PhoneNumber();
+}
+
+Contact ContactView::toContact() const {
+    // вся запись одним проходом: поля по порядку, затем телефоны
+    Reader in{m_data, m_size, m_record, true};
+    string fields[6];
+    for (auto& field : fields) in.str(field);
+
+    PhoneList phones;
+    int count = static_cast<int>(in.uint(2));
+    for (int i = 0; i < count && in.ok; ++i) {
+        PhoneNumber phone = readPhone(in, true);
+        if (in.ok) phones.push_back(std::move(phone));
+    }
+
+    return Contact(std::move(fields[0]), std::move(fields[1]), std::move(fields[2]),
+                   std::move(fields[3]), std::move(fields[4]), std::move(fields[5]), std::move(phones));
+}
+
+// MappedRepository
+
+MappedRepository::MappedRepository(const string& filename)
+    : m_filename(filename)
+{
+    if (!map()) return;
+
+    // Проверяем только заголовок и таблицы - сами записи читаются по запросу
+    Reader in{m_data, m_size, 0, true};
+    if (m_size < BinaryRepository::HEADER_SIZE ||
+        memcmp(m_data, BinaryRepository::MAGIC, sizeof(BinaryRepository::MAGIC)) != 0) {
+        LOG_ERROR("[MappedRepository] Not a phonebook snapshot: " << filename);
+        unmap();
+        return;
+    }
+
+    in.pos = sizeof(BinaryRepository::MAGIC);
+    uint16_t version = static_cast<uint16_t>(in.uint(2));
+    in.uint(2); // флаги
+    m_count = static_cast<uint32_t>(in.uint(4));
+
+    // таблицы смещений и порядка по email
+    if (version != BinaryRepository::FORMAT_VERSION || !in.need(static_cast<size_t>(m_count) * 4 * 2)) {
+        LOG_ERROR("[MappedRepository] Unsupported or damaged snapshot: " << filename);
+        unmap();
+        return;
+    }
+}
+
+MappedRepository::~MappedRepository() {
+    unmap();
+}
+
+#ifdef _WIN32
+
+bool MappedRepository::map() {
+    HANDLE file = CreateFileA(m_filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        LOG_WARNING("[MappedRepository] Could not open file: " << m_filename);
+        return false;
+    }
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+        LOG_WARNING("[MappedRepository] File is empty: " << m_filename);
+        CloseHandle(file);
+        return false;
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    void* view = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if (!view) {
+        LOG_ERROR("[MappedRepository] Could not map file: " << m_filename);
+        if (mapping) CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+
+    m_file = file;
+    m_mapping = mapping;
+    m_data = static_cast<const char*>(view);
+    m_size = static_cast<size_t>(size.QuadPart);
+    return true;
+}
+
+void MappedRepository::unmap() {
+    if (m_data) UnmapViewOfFile(m_data);
+    if (m_mapping) CloseHandle(m_mapping);
+    if (m_file) CloseHandle(m_file);
+    m_data = nullptr;
+    m_mapping = nullptr;
+    m_file = nullptr;
+    m_size = 0;
+    m_count = 0;
+}
+
+#else
+
+bool MappedRepository::map() {
+    int fd = open(m_filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        LOG_WARNING("[MappedRepository] Could not open file: " << m_filename);
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0) {
+        LOG_WARNING("[MappedRepository] File is empty: " << m_filename);
+        close(fd);
+        return false;
+    }
+
+    void* view = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+    close(fd); // отображение держит файл само
+    if (view == MAP_FAILED) {
+        LOG_ERROR("[MappedRepository] Could not map file: " << m_filename);
+        return false;
+    }
+
+    m_data = static_cast<const char*>(view);
+    m_size = static_cast<size_t>(st.st_size);
+    return true;
+}
+
+void MappedRepository::unmap() {
+    if (m_data) munmap(const_cast<char*>(m_data), m_size);
+    m_data = nullptr;
+    m_size = 0;
+    m_count = 0;
+}
+
+#endif
+
+size_t MappedRepository::recordOffset(uint32_t index) const {
+    Reader in{m_data, m_size, BinaryRepository::HEADER_SIZE + static_cast<size_t>(index) * 4, true};
+    return static_cast<size_t>(in.uint(4));
+}
+
+ContactView MappedRepository::at(size_t index) const {
+    return ContactView(m_data, m_size, recordOffset(static_cast<uint32_t>(index)));
+}
+
+optional<ContactView> MappedRepository::find(string_view email) const {
+    if (!is_open()) return nullopt;
+
+    const size_t byEmail = BinaryRepository::HEADER_SIZE + static_cast<size_t>(m_count) * 4;
+    auto entry = [&](uint32_t pos) {
+        Reader in{m_data, m_size, byEmail + static_cast<size_t>(pos) * 4, true};
+        return at(static_cast<uint32_t>(in.uint(4)));
+    };
+
+    uint32_t lo = 0, hi = m_count;
+    while (lo < hi) {
+        uint32_t mid = lo + (hi - lo) / 2;
+        if (entry(mid).email() < email) lo = mid + 1;
+        else hi = mid;
+    }
+    if (lo < m_count && entry(lo).email() == email) return entry(lo);
+    return nullopt;
+}
+
+// IContactRepository: только чтение
+
+bool MappedRepository::addContact(const Contact&) {
+    LOG_WARNING("[MappedRepository] Repository is read-only");
+    return false;
+}
+
+bool MappedRepository::removeContact(const string&) {
+    LOG_WARNING("[MappedRepository] Repository is read-only");
+    return false;
+}
+
+bool MappedRepository::updateContact(const Contact&) {
+    LOG_WARNING("[MappedRepository] Repository is read-only");
+    return false;
+}
+
+bool MappedRepository::replaceAllContacts(const vector<Contact>&) {
+    LOG_WARNING("[MappedRepository] Repository is read-only");
+    return false;
+}
+
+Contact MappedRepository::getContact(const string& email) const {
+    optional<ContactView> view = find(email);
+    if (view) return view->toContact();
+
+    return Contact(); // пустой контакт
+}
+
+vector<Contact> MappedRepository::getAllContacts() const {
+    vector<Contact> result;
+    result.reserve(m_count);
+    for (uint32_t i = 0; i < m_count; ++i) {
+        result.push_back(at(i).toContact());
+    }
+    return result;
+}
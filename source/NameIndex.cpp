@@ -0,0 +1,494 @@
+#include "NameIndex.h"
+#include <algorithm>
+#include <iterator>
+
+// Кириллица в UTF-8 - два байта: U+0400..U+043F начинаются с 0xD0, U+0440..U+047F - с 0xD1
+string NameIndex::fold(const string& text) {
+    string result;
+    result.reserve(text.size());
+
+    for (size_t i = 0; i < text.size(); ++i) {
+        unsigned char c = text[i];
+        unsigned char next = i + 1 < text.size() ? static_cast<unsigned char>(text[i + 1]) : 0;
+
+        if (c < 0x80) {
+            // ASCII - без учёта локали
+            result += (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : static_cast<char>(c);
+            continue;
+        }
+
+        if (c == 0xD0 && next >= 0x80 && next <= 0xBF) {
+            ++i;
+            if (next == 0x81) {                       // Ё -> е
+                result += "\xD0\xB5";
+            } else if (next <= 0x8F) {                // Ѐ..Џ (U+0400..040F) -> ѐ..џ (U+0450..045F)
+                result += '\xD1';
+                result += static_cast<char>(next + 0x10);
+            } else if (next <= 0x9F) {                // А..П -> а..п
+                result += '\xD0';
+                result += static_cast<char>(next + 0x20);
+            } else if (next <= 0xAF) {                // Р..Я -> р..я
+                result += '\xD1';
+                result += static_cast<char>(next - 0x20);
+            } else {                                  // а..п уже строчные
+                result += '\xD0';
+                result += static_cast<char>(next);
+            }
+            continue;
+        }
+
+        if (c == 0xD1 && next == 0x91) {              // ё -> е
+            ++i;
+            result += "\xD0\xB5";
+            continue;
+        }
+
+        if (c == 0xC3 && next >= 0x80 && next <= 0x9E && next != 0x97) {
+            ++i;                                      // À..Þ -> à..þ (кроме знака умножения)
+            result += '\xC3';
+            result += static_cast<char>(next + 0x20);
+            continue;
+        }
+
+        result += static_cast<char>(c);
+    }
+    return result;
+}
+
+string NameIndex::transliterate(const string& folded) {
+    // а..п (0xD0 0xB0..0xBF) и р..я (0xD1 0x80..0x8F)
+    static const char* const LOWER[32] = {
+        "a", "b", "v", "g", "d", "e", "zh", "z", "i", "y", "k", "l", "m", "n", "o", "p",
+        "r", "s", "t", "u", "f", "kh", "ts", "ch", "sh", "shch", "", "y", "", "e", "yu", "ya"
+    };
+
+    string result;
+    result.reserve(folded.size());
+
+    for (size_t i = 0; i < folded.size(); ++i) {
+        unsigned char c = folded[i];
+        unsigned char next = i + 1 < folded.size() ? static_cast<unsigned char>(folded[i + 1]) : 0;
+
+        if (c == 0xD0 && next >= 0xB0 && next <= 0xBF) {
+            result += LOWER[next - 0xB0];
+            ++i;
+        } else if (c == 0xD1 && next >= 0x80 && next <= 0x8F) {
+            result += LOWER[next - 0x80 + 16];
+            ++i;
+        } else if (c == 0xD1 && next == 0x96) {       // і
+            result += 'i';
+            ++i;
+        } else if (c == 0xD1 && next == 0x97) {       // ї
+            result += "yi";
+            ++i;
+        } else if (c == 0xD1 && next == 0x94) {       // є
+            result += "ye";
+            ++i;
+        } else {
+            result += static_cast<char>(c);
+        }
+    }
+    return result;
+}
+
+string NameIndex::key_of(const Contact& contact) {
+    string full;
+    full.reserve(contact.ref_firstName().size() + contact.ref_lastName().size()
+                 + contact.ref_patronymic().size() + 2);
+    full += contact.ref_firstName();
+    full += ' ';
+    full += contact.ref_lastName();
+    full += ' ';
+    full += contact.ref_patronymic();
+    return fold(full);
+}
+
+uint32_t NameIndex::trigram(const string& text, size_t pos) {
+    return static_cast<uint32_t>(static_cast<unsigned char>(text[pos])) << 16
+         | static_cast<uint32_t>(static_cast<unsigned char>(text[pos + 1])) << 8
+         | static_cast<uint32_t>(static_cast<unsigned char>(text[pos + 2]));
+}
+
+bool NameIndex::PostingList::contains(size_t slot) const {
+    auto it = lower_bound(entries.begin(), entries.end(), slot << 1);
+    return it != entries.end() && *it == ((slot << 1) | 1);
+}
+
+void NameIndex::addPostings(const string& key, size_t slot) {
+    for (size_t i = 0; i + 3 <= key.size(); ++i) {
+        PostingList& list = m_postings[trigram(key, i)];
+        auto it = lower_bound(list.entries.begin(), list.entries.end(), slot << 1);
+        if (it != list.entries.end() && (*it >> 1) == slot) {
+            // тройка уже была в ключе (повтор) или осталась от erase при обновлении - без сдвига
+            if (!(*it & 1)) {
+                *it |= 1;
+                --list.dead;
+            }
+        } else {
+            // новые контакты получают самый большой слот - обычно это просто push_back
+            list.entries.insert(it, (slot << 1) | 1);
+        }
+    }
+}
+
+void NameIndex::removePostings(const string& key, size_t slot) {
+    for (size_t i = 0; i + 3 <= key.size(); ++i) {
+        auto posting = m_postings.find(trigram(key, i));
+        if (posting == m_postings.end()) continue;
+
+        PostingList& list = posting->second;
+        auto it = lower_bound(list.entries.begin(), list.entries.end(), slot << 1);
+        if (it != list.entries.end() && *it == ((slot << 1) | 1)) {
+            *it &= ~size_t(1);   // только пометка - сдвиг длинного списка был бы O(N)
+            ++list.dead;
+        }
+
+        if (list.alive() == 0) m_postings.erase(posting);
+        else compact(list);
+    }
+}
+
+void NameIndex::compact(PostingList& list) {
+    if (list.dead < 32 || list.dead < list.alive()) return; // удалённых пока немного
+
+    list.entries.erase(remove_if(list.entries.begin(), list.entries.end(),
+                                 [](size_t entry) { return !(entry & 1); }),
+                       list.entries.end());
+    list.dead = 0;
+}
+
+uint64_t NameIndex::signature(const string& text) {
+    uint64_t bits = 0;
+    uint32_t code = 0;
+    for (size_t i = 0; i < text.size(); ++i) {
+        unsigned char c = text[i];
+        code = (c & 0xC0) == 0x80 ? (code << 6) | (c & 0x3F) : c;
+        // символ закончился - отмечаем его бит
+        if (i + 1 == text.size() || (static_cast<unsigned char>(text[i + 1]) & 0xC0) != 0x80)
+            bits |= 1ULL << ((code * 0x9E3779B1u) >> 26);
+    }
+    return bits;
+}
+
+void NameIndex::insert(size_t slot, const Contact& contact) {
+    if (slot >= m_keys.size()) {
+        m_keys.resize(slot + 1);
+        m_translit.resize(slot + 1);
+        m_used.resize(slot + 1, false);
+        m_signature.resize(slot + 1, 0);
+    }
+    if (m_used[slot]) erase(slot);
+
+    // ключи считаются один раз здесь, а не на каждый поиск
+    m_keys[slot] = key_of(contact);
+    m_signature[slot] = signature(m_keys[slot]);
+    string translit = transliterate(m_keys[slot]);
+    if (translit != m_keys[slot]) m_translit[slot] = std::move(translit);
+    m_used[slot] = true;
+
+    // тройки обоих ключей лежат в общих списках, лишних кандидатов отсеет проверка подстроки
+    addPostings(m_keys[slot], slot);
+    if (!m_translit[slot].empty()) addPostings(m_translit[slot], slot);
+}
+
+void NameIndex::erase(size_t slot) {
+    if (slot >= m_keys.size() || !m_used[slot]) return;
+
+    removePostings(m_keys[slot], slot);
+    if (!m_translit[slot].empty()) removePostings(m_translit[slot], slot);
+
+    string().swap(m_keys[slot]);
+    string().swap(m_translit[slot]);
+    m_used[slot] = false;
+}
+
+void NameIndex::clear() {
+    m_keys.clear();
+    m_translit.clear();
+    m_used.clear();
+    m_signature.clear();
+    m_postings.clear();
+}
+
+vector<size_t> NameIndex::search(const string& query, bool translit) const {
+    vector<size_t> result = searchIn(query, false);
+    if (!translit) return result;
+
+    vector<size_t> byTranslit = searchIn(transliterate(query), true);
+    vector<size_t> merged;
+    merged.reserve(result.size() + byTranslit.size());
+    set_union(result.begin(), result.end(), byTranslit.begin(), byTranslit.end(), back_inserter(merged));
+    return merged;
+}
+
+vector<size_t> NameIndex::searchIn(const string& query, bool inTranslit) const {
+    vector<size_t> result;
+    auto matches = [&](size_t slot) {
+        const string& key = inTranslit ? translitKey(slot) : m_keys[slot];
+        return key.find(query) != string::npos;
+    };
+
+    if (query.size() < 3) {
+        // короткий запрос - троек нет, проверяем ключи подряд (сами контакты не трогаем)
+        for (size_t slot = 0; slot < m_keys.size(); ++slot) {
+            if (m_used[slot] && matches(slot)) result.push_back(slot);
+        }
+        return result;
+    }
+
+    // разные тройки запроса
+    vector<uint32_t> grams;
+    for (size_t i = 0; i + 3 <= query.size(); ++i) grams.push_back(trigram(query, i));
+    sort(grams.begin(), grams.end());
+    grams.erase(unique(grams.begin(), grams.end()), grams.end());
+
+    // их списки слотов; если какой-то тройки нет - совпадений нет
+    vector<const PostingList*> lists;
+    for (uint32_t gram : grams) {
+        auto posting = m_postings.find(gram);
+        if (posting == m_postings.end()) return result;
+        lists.push_back(&posting->second);
+    }
+    sort(lists.begin(), lists.end(),
+         [](const PostingList* a, const PostingList* b) { return a->alive() < b->alive(); });
+
+    // идём по самому короткому списку, остальные проверяем двоичным поиском
+    for (size_t entry : lists.front()->entries) {
+        if (!(entry & 1)) continue;
+        const size_t slot = entry >> 1;
+        bool inAll = true;
+        for (size_t i = 1; i < lists.size() && inAll; ++i) {
+            inAll = lists[i]->contains(slot);
+        }
+        // тройки могут стоять не подряд - окончательно проверяем подстроку
+        if (inAll && matches(slot)) result.push_back(slot);
+    }
+    return result;
+}
+
+// Нечёткий поиск
+
+// UTF-8 -> коды символов (неправильные байты берутся как есть)
+static void decode_utf8(const string& text, vector<uint32_t>& out) {
+    out.clear();
+    for (size_t i = 0; i < text.size();) {
+        unsigned char c = text[i];
+        size_t len = c < 0x80 ? 1 : (c >> 5) == 0x6 ? 2 : (c >> 4) == 0xE ? 3 : (c >> 3) == 0x1E ? 4 : 1;
+        if (i + len > text.size()) len = 1;
+
+        uint32_t code = len == 1 ? c : len == 2 ? (c & 0x1F) : len == 3 ? (c & 0x0F) : (c & 0x07);
+        for (size_t j = 1; j < len; ++j) code = (code << 6) | (static_cast<unsigned char>(text[i + j]) & 0x3F);
+        out.push_back(code);
+        i += len;
+    }
+}
+
+// Шаблон для алгоритма Майерса (поиск с ошибками, шаблон до 64 символов):
+// для каждого символа шаблона - маска позиций, где он стоит.
+// Латиница и кириллица ищутся в таблице, остальные символы - в коротком списке
+class FuzzyPattern {
+public:
+    static const size_t MAX_LENGTH = 64;
+    static const uint32_t TABLE_SIZE = 0x500;
+
+    explicit FuzzyPattern(const vector<uint32_t>& pattern)
+        : m_length(pattern.size()), m_table(TABLE_SIZE, 0)
+    {
+        for (size_t i = 0; i < pattern.size(); ++i) {
+            uint64_t bit = 1ULL << i;
+            if (pattern[i] < TABLE_SIZE) {
+                m_table[pattern[i]] |= bit;
+                continue;
+            }
+            auto it = find_if(m_other.begin(), m_other.end(),
+                              [&](const pair<uint32_t, uint64_t>& e) { return e.first == pattern[i]; });
+            if (it == m_other.end()) m_other.push_back({pattern[i], bit});
+            else it->second |= bit;
+        }
+    }
+
+    // наименьшее число правок шаблона до подстроки text; при результате больше limit
+    // может остановиться раньше и вернуть любое значение больше limit
+    size_t distance(const vector<uint32_t>& text, size_t limit) const {
+        if (m_length == 0) return 0;
+
+        const uint64_t high = 1ULL << (m_length - 1);
+        uint64_t pv = m_length == 64 ? ~0ULL : (1ULL << m_length) - 1;
+        uint64_t mv = 0;
+        size_t score = m_length;
+        size_t best = score;
+
+        for (size_t j = 0; j < text.size(); ++j) {
+            uint64_t eq = mask(text[j]);
+            uint64_t xv = eq | mv;
+            uint64_t xh = (((eq & pv) + pv) ^ pv) | eq;
+            uint64_t ph = mv | ~(xh | pv);
+            uint64_t mh = pv & xh;
+
+            if (ph & high) ++score;
+            else if (mh & high) --score;
+
+            // поиск подстроки: начало совпадения в тексте бесплатное, поэтому снизу ничего не вдвигаем
+            ph <<= 1;
+            mh <<= 1;
+            pv = mh | ~(xv | ph);
+            mv = ph & xv;
+
+            if (score < best) best = score;
+            // за каждый оставшийся символ счёт уменьшается не больше чем на 1
+            if (score > limit + (text.size() - j - 1) && best > limit) return best;
+        }
+        return best;
+    }
+
+private:
+    size_t m_length;
+    vector<uint64_t> m_table;
+    vector<pair<uint32_t, uint64_t>> m_other;
+
+    uint64_t mask(uint32_t code) const {
+        if (code < TABLE_SIZE) return m_table[code];
+        for (const auto& e : m_other) {
+            if (e.first == code) return e.second;
+        }
+        return 0;
+    }
+};
+
+static size_t count_bits(uint64_t bits) {
+    size_t count = 0;
+    for (; bits; bits &= bits - 1) ++count;
+    return count;
+}
+
+// Обычная динамика для шаблонов длиннее 64 символов (на практике не встречаются)
+static size_t dp_distance(const vector<uint32_t>& pattern, const vector<uint32_t>& text) {
+    vector<size_t> column(pattern.size() + 1);
+    for (size_t i = 0; i <= pattern.size(); ++i) column[i] = i;
+
+    size_t best = pattern.size();
+    for (uint32_t c : text) {
+        size_t diagonal = 0; // начало совпадения в тексте бесплатное
+        column[0] = 0;
+        for (size_t i = 1; i <= pattern.size(); ++i) {
+            size_t up = column[i];
+            column[i] = min({column[i] + 1, column[i - 1] + 1, diagonal + (pattern[i - 1] == c ? 0 : 1)});
+            diagonal = up;
+        }
+        best = min(best, column[pattern.size()]);
+    }
+    return best;
+}
+
+size_t NameIndex::fuzzy_distance(const string& query, const string& text) {
+    vector<uint32_t> pattern, codes;
+    decode_utf8(query, pattern);
+    decode_utf8(text, codes);
+
+    if (pattern.size() > FuzzyPattern::MAX_LENGTH) return dp_distance(pattern, codes);
+    return FuzzyPattern(pattern).distance(codes, pattern.size());
+}
+
+vector<pair<size_t, size_t>> NameIndex::fuzzy(const string& query, size_t maxErrors, size_t k) const {
+    vector<pair<size_t, size_t>> result;
+    if (k == 0) return result;
+
+    vector<uint32_t> pattern;
+    decode_utf8(query, pattern);
+    if (pattern.size() <= maxErrors) {
+        // столько правок превращают запрос в пустую строку - подходит любой контакт
+        maxErrors = pattern.size();
+    }
+
+    vector<size_t> candidates;
+
+    // Отбор кандидатов. Разрежем запрос на maxErrors + 1 кусков: правок меньше, чем кусков,
+    // значит хотя бы один кусок входит в подходящий ключ без изменений.
+    // Кандидаты - объединение точных совпадений кусков (их ищет обычный триграммный поиск)
+    vector<size_t> starts; // байтовые начала символов запроса
+    for (size_t i = 0; i < query.size(); ++i) {
+        if ((static_cast<unsigned char>(query[i]) & 0xC0) != 0x80) starts.push_back(i);
+    }
+    starts.push_back(query.size());
+
+    const size_t pieces = maxErrors + 1;
+    bool piecesUsable = pattern.size() >= pieces && starts.size() == pattern.size() + 1;
+    for (size_t p = 0; piecesUsable && p < pieces; ++p) {
+        size_t from = starts[p * pattern.size() / pieces];
+        size_t to = starts[(p + 1) * pattern.size() / pieces];
+        piecesUsable = to - from >= 3; // по куску короче трёх байт индекс не поможет
+    }
+
+    if (piecesUsable) {
+        for (size_t p = 0; p < pieces; ++p) {
+            size_t from = starts[p * pattern.size() / pieces];
+            size_t to = starts[(p + 1) * pattern.size() / pieces];
+
+            vector<size_t> found = searchIn(query.substr(from, to - from), false);
+            vector<size_t> merged;
+            merged.reserve(candidates.size() + found.size());
+            set_union(candidates.begin(), candidates.end(), found.begin(), found.end(), back_inserter(merged));
+            candidates.swap(merged);
+        }
+    } else {
+        // Куски слишком короткие - отбираем по числу общих троек: одна правка символа
+        // (до 2 байт в UTF-8) задевает не больше 4 троек, значит у подходящего ключа есть хотя бы
+        // (число разных троек запроса - 4 * maxErrors) из них
+        vector<uint32_t> grams;
+        for (size_t i = 0; i + 3 <= query.size(); ++i) grams.push_back(trigram(query, i));
+        sort(grams.begin(), grams.end());
+        grams.erase(unique(grams.begin(), grams.end()), grams.end());
+
+        size_t needed = grams.size() > 4 * maxErrors ? grams.size() - 4 * maxErrors : 0;
+        if (needed == 0) {
+            // фильтр ничего не отсеет - проверяем все ключи
+            for (size_t slot = 0; slot < m_keys.size(); ++slot) {
+                if (m_used[slot]) candidates.push_back(slot);
+            }
+        } else {
+            vector<uint32_t> counts(m_keys.size(), 0);
+            for (uint32_t gram : grams) {
+                auto posting = m_postings.find(gram);
+                if (posting == m_postings.end()) continue;
+                for (size_t entry : posting->second.entries) {
+                    if ((entry & 1) && ++counts[entry >> 1] == needed) candidates.push_back(entry >> 1);
+                }
+            }
+            sort(candidates.begin(), candidates.end());
+        }
+    }
+
+    // лучшие k по (число правок, слот); когда набралось k, порог ужесточается
+    vector<uint32_t> codes;
+    size_t limit = maxErrors;
+    auto byDistance = [](const pair<size_t, size_t>& a, const pair<size_t, size_t>& b) {
+        return a.second != b.second ? a.second < b.second : a.first < b.first;
+    };
+
+    const bool small = pattern.size() <= FuzzyPattern::MAX_LENGTH;
+    FuzzyPattern bits(small ? pattern : vector<uint32_t>());
+
+    // каждая правка убирает из запроса не больше одного символа, а значит и одного бита подписи
+    const uint64_t querySignature = signature(query);
+    const size_t queryBits = count_bits(querySignature);
+
+    for (size_t slot : candidates) {
+        if (count_bits(querySignature & m_signature[slot]) + limit < queryBits)
+            continue;
+
+        decode_utf8(m_keys[slot], codes);
+        size_t distance = small ? bits.distance(codes, limit) : dp_distance(pattern, codes);
+        if (distance > limit) continue;
+
+        result.push_back({slot, distance});
+        push_heap(result.begin(), result.end(), byDistance);
+        if (result.size() > k) {
+            pop_heap(result.begin(), result.end(), byDistance);
+            result.pop_back();
+        }
+        if (result.size() == k) limit = min(limit, result.front().second);
+    }
+
+    sort_heap(result.begin(), result.end(), byDistance);
+    return result;
+}
@@ -0,0 +1,373 @@
+#include "PhoneBatch.h"
+#include <cstring>
+
+// Векторные ядра есть только для x86; на остальных процессорах работает обычный цикл
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define PHONEBATCH_X86 1
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+// GCC и Clang собирают SSSE3- и AVX2-функции без флагов для всего файла: набор инструкций
+// указывается у самой функции, а вызывается она только если процессор его поддерживает
+#if defined(__GNUC__)
+#define TARGET_SSSE3 __attribute__((target("ssse3")))
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define TARGET_SSSE3
+#define TARGET_AVX2
+#endif
+
+using namespace std;
+
+static const uint64_t KEY_11_DIGITS = 11ULL << 56;     // длина 11 в ключе (см. PhoneNumber::key_of)
+static const uint64_t RU_PREFIX = 70000000000ULL;      // 7 и десять нулей
+static const size_t PHONE_DIGITS = 11;
+
+static bool is_separator(char c) {
+    return c == ' ' || c == '-' || c == '(' || c == ')' || c == '+';
+}
+
+static bool is_trimmed(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+// Обычный цикл: те же правила, что в Validators::validate_phone, и сразу ключ
+static bool scan_scalar(const char* text, size_t length, uint64_t& key) {
+    size_t begin = 0, end = length;
+    while (begin < end && is_trimmed(text[begin])) ++begin;
+    while (end > begin && is_trimmed(text[end - 1])) --end;
+    if (begin == end) return false;
+
+    const char code = text[begin] == '+' ? '7' : '8';
+    size_t digits = 0;
+    uint64_t value = 0;   // десять цифр после кода
+    for (size_t i = begin; i < end; ++i) {
+        char c = text[i];
+        if (is_separator(c)) continue;
+        if (c < '0' || c > '9') return false;
+
+        if (digits == 0) {
+            if (c != code) return false;
+        } else {
+            if (digits == PHONE_DIGITS) return false;
+            value = value * 10 + static_cast<uint64_t>(c - '0');
+        }
+        ++digits;
+    }
+    if (digits != PHONE_DIGITS) return false;
+
+    key = KEY_11_DIGITS | (RU_PREFIX + value);
+    return true;
+}
+
+static void store(uint64_t* keys, uint64_t* valid, size_t index, bool ok, uint64_t key) {
+    keys[index] = ok ? key : 0;
+    if (ok) valid[index / 64] |= 1ULL << (index % 64);
+}
+
+#ifdef PHONEBATCH_X86
+
+#ifdef _MSC_VER
+static inline int lowest_bit(uint32_t bits) { unsigned long i; _BitScanForward(&i, bits); return static_cast<int>(i); }
+static inline int highest_bit(uint32_t bits) { unsigned long i; _BitScanReverse(&i, bits); return static_cast<int>(i); }
+static inline int count_bits(uint32_t bits) { int n = 0; for (; bits; bits &= bits - 1) ++n; return n; }
+#else
+static inline int lowest_bit(uint32_t bits) { return __builtin_ctz(bits); }
+static inline int highest_bit(uint32_t bits) { return 31 - __builtin_clz(bits); }
+static inline int count_bits(uint32_t bits) { return __builtin_popcount(bits); }
+#endif
+
+// Проверка номера не длиннее 16 байт по маскам (бит на байт): digits - цифры,
+// separators - разделители, trimmed - символы, которые validate_phone убирает по краям.
+// Для валидного номера в digits остаются десять цифр после кода
+static bool check(const char* text, size_t length, uint32_t& digits, uint32_t separators, uint32_t trimmed) {
+    const uint32_t inside = (1u << length) - 1;
+    const uint32_t content = inside & ~trimmed;
+    if (content == 0) return false;
+
+    // от первого до последнего символа, не убранного по краям, - только цифры и разделители
+    const int first = lowest_bit(content), last = highest_bit(content);
+    const uint32_t middle = ((1u << (last + 1)) - 1) & ~((1u << first) - 1);
+    if (middle & ~(digits | separators)) return false;
+
+    digits &= middle;
+    if (count_bits(digits) != static_cast<int>(PHONE_DIGITS)) return false;
+    if (text[lowest_bit(digits)] != (text[first] == '+' ? '7' : '8')) return false;
+
+    digits &= digits - 1;   // код (7 или 8) в ключ не входит - там всегда 7
+    return true;
+}
+
+// Позиции единичных битов байта по порядку (остаток - 0x80, pshufb даёт на них ноль)
+struct CompressTable {
+    uint8_t positions[256][8];
+};
+
+constexpr CompressTable build_compress_table() {
+    CompressTable table{};
+    for (int mask = 0; mask < 256; ++mask) {
+        int n = 0;
+        for (int bit = 0; bit < 8; ++bit) {
+            if (mask & (1 << bit)) table.positions[mask][n++] = static_cast<uint8_t>(bit);
+        }
+        while (n < 8) table.positions[mask][n++] = 0x80;
+    }
+    return table;
+}
+
+static constexpr CompressTable COMPRESS = build_compress_table();
+
+// Маска перестановки для pshufb: десять цифр из digits - в байты 6..15 по порядку, байты 0..5 - нули.
+// Тогда 16 байт читаются как 16-значное число с ведущими нулями
+static void digit_shuffle(uint32_t digits, uint8_t* shuffle) {
+    memset(shuffle, 0x80, 6);
+    const uint32_t low = digits & 0xFF, high = (digits >> 8) & 0xFF;
+    memcpy(shuffle + 6, COMPRESS.positions[low], 8);
+
+    uint64_t highPositions;
+    memcpy(&highPositions, COMPRESS.positions[high], 8);
+    highPositions += 0x0808080808080808ULL;   // позиции старшей половины - с 8-го байта
+    memcpy(shuffle + 6 + count_bits(low), &highPositions, 8);
+}
+
+// 16 байт начиная с text. Если до конца столбца меньше 16 байт - через копию
+// (байты после номера всё равно отбрасываются маской длины)
+static const char* load_source(const char* text, size_t length, const char* end, char* copy) {
+    if (end - text >= 16) return text;
+    memset(copy, 0, 16);
+    memcpy(copy, text, length);
+    return copy;
+}
+
+// 16 цифр (значения 0..9, по байту) -> две половины по 8 цифр в 32-битных словах 0 и 1:
+// пары цифр -> 2-значные, -> 4-значные, -> 8-значные
+TARGET_SSSE3
+static uint64_t fold_digits(__m128i values) {
+    const __m128i pairs = _mm_maddubs_epi16(values, _mm_set1_epi16(0x010A));            // *10 + 1
+    const __m128i quads = _mm_madd_epi16(pairs, _mm_set1_epi32(0x00010064));            // *100 + 1
+    const __m128i packed = _mm_packs_epi32(quads, quads);
+    const __m128i octets = _mm_madd_epi16(packed, _mm_set1_epi32(0x00012710));          // *10000 + 1
+    return static_cast<uint64_t>(static_cast<uint32_t>(_mm_cvtsi128_si32(octets))) * 100000000ULL
+         + static_cast<uint32_t>(_mm_cvtsi128_si32(_mm_srli_si128(octets, 4)));
+}
+
+TARGET_SSSE3
+static bool scan_ssse3(const char* text, size_t length, const char* end, uint64_t& key) {
+    if (length > 16) return scan_scalar(text, length, key);
+
+    char copy[16];
+    const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(load_source(text, length, end, copy)));
+
+    // цифра: c - '0' без знака не больше 9
+    const __m128i values = _mm_sub_epi8(c, _mm_set1_epi8('0'));
+    const __m128i digit = _mm_cmpeq_epi8(_mm_min_epu8(values, _mm_set1_epi8(9)), values);
+
+    const __m128i space = _mm_cmpeq_epi8(c, _mm_set1_epi8(' '));
+    const __m128i separator = _mm_or_si128(
+        _mm_or_si128(space, _mm_cmpeq_epi8(c, _mm_set1_epi8('-'))),
+        _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(c, _mm_set1_epi8('(')), _mm_cmpeq_epi8(c, _mm_set1_epi8(')'))),
+                     _mm_cmpeq_epi8(c, _mm_set1_epi8('+'))));
+    const __m128i trimmed = _mm_or_si128(
+        _mm_or_si128(space, _mm_cmpeq_epi8(c, _mm_set1_epi8('\t'))),
+        _mm_or_si128(_mm_cmpeq_epi8(c, _mm_set1_epi8('\n')), _mm_cmpeq_epi8(c, _mm_set1_epi8('\r'))));
+
+    uint32_t digits = static_cast<uint32_t>(_mm_movemask_epi8(digit));
+    if (!check(text, length, digits,
+               static_cast<uint32_t>(_mm_movemask_epi8(separator)),
+               static_cast<uint32_t>(_mm_movemask_epi8(trimmed)))) return false;
+
+    uint8_t shuffle[24];
+    digit_shuffle(digits, shuffle);
+    const __m128i ordered = _mm_shuffle_epi8(values, _mm_loadu_si128(reinterpret_cast<const __m128i*>(shuffle)));
+
+    key = KEY_11_DIGITS | (RU_PREFIX + fold_digits(ordered));
+    return true;
+}
+
+TARGET_SSSE3
+static size_t normalize_ssse3(const char* data, const size_t* offsets, size_t count,
+                              uint64_t* keys, uint64_t* valid) {
+    const char* end = data + offsets[count];
+    size_t validCount = 0;
+    for (size_t i = 0; i < count; ++i) {
+        uint64_t key = 0;
+        bool ok = scan_ssse3(data + offsets[i], offsets[i + 1] - offsets[i], end, key);
+        store(keys, valid, i, ok, key);
+        validCount += ok;
+    }
+    return validCount;
+}
+
+// Два номера за раз: первый - в младших 16 байтах регистра, второй - в старших
+// (pshufb и сложения AVX2 работают в каждой половине отдельно, как два SSE-регистра)
+TARGET_AVX2
+static size_t normalize_avx2(const char* data, const size_t* offsets, size_t count,
+                             uint64_t* keys, uint64_t* valid) {
+    const char* end = data + offsets[count];
+    size_t validCount = 0;
+    size_t i = 0;
+    for (; i + 1 < count; i += 2) {
+        const char* textA = data + offsets[i];
+        const char* textB = data + offsets[i + 1];
+        const size_t lengthA = offsets[i + 1] - offsets[i];
+        const size_t lengthB = offsets[i + 2] - offsets[i + 1];
+        uint64_t keyA = 0, keyB = 0;
+        bool okA, okB;
+
+        if (lengthA > 16 || lengthB > 16) {
+            okA = scan_ssse3(textA, lengthA, end, keyA);
+            okB = scan_ssse3(textB, lengthB, end, keyB);
+        } else {
+            char copyA[16], copyB[16];
+            const __m256i c = _mm256_inserti128_si256(
+                _mm256_castsi128_si256(_mm_loadu_si128(
+                    reinterpret_cast<const __m128i*>(load_source(textA, lengthA, end, copyA)))),
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(load_source(textB, lengthB, end, copyB))), 1);
+
+            const __m256i values = _mm256_sub_epi8(c, _mm256_set1_epi8('0'));
+            const __m256i digit = _mm256_cmpeq_epi8(_mm256_min_epu8(values, _mm256_set1_epi8(9)), values);
+
+            const __m256i space = _mm256_cmpeq_epi8(c, _mm256_set1_epi8(' '));
+            const __m256i separator = _mm256_or_si256(
+                _mm256_or_si256(space, _mm256_cmpeq_epi8(c, _mm256_set1_epi8('-'))),
+                _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(c, _mm256_set1_epi8('(')),
+                                                _mm256_cmpeq_epi8(c, _mm256_set1_epi8(')'))),
+                                _mm256_cmpeq_epi8(c, _mm256_set1_epi8('+'))));
+            const __m256i trimmed = _mm256_or_si256(
+                _mm256_or_si256(space, _mm256_cmpeq_epi8(c, _mm256_set1_epi8('\t'))),
+                _mm256_or_si256(_mm256_cmpeq_epi8(c, _mm256_set1_epi8('\n')),
+                                _mm256_cmpeq_epi8(c, _mm256_set1_epi8('\r'))));
+
+            const uint32_t digits = static_cast<uint32_t>(_mm256_movemask_epi8(digit));
+            const uint32_t separators = static_cast<uint32_t>(_mm256_movemask_epi8(separator));
+            const uint32_t trims = static_cast<uint32_t>(_mm256_movemask_epi8(trimmed));
+
+            uint32_t digitsA = digits & 0xFFFF, digitsB = digits >> 16;
+            okA = check(textA, lengthA, digitsA, separators & 0xFFFF, trims & 0xFFFF);
+            okB = check(textB, lengthB, digitsB, separators >> 16, trims >> 16);
+
+            // невалидный номер получает пустую перестановку - его половина просто не используется
+            uint8_t shuffle[2][24];
+            if (okA) digit_shuffle(digitsA, shuffle[0]); else memset(shuffle[0], 0x80, 16);
+            if (okB) digit_shuffle(digitsB, shuffle[1]); else memset(shuffle[1], 0x80, 16);
+            const __m256i ordered = _mm256_shuffle_epi8(values, _mm256_inserti128_si256(
+                _mm256_castsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(shuffle[0]))),
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(shuffle[1])), 1));
+
+            const __m256i pairs = _mm256_maddubs_epi16(ordered, _mm256_set1_epi16(0x010A));
+            const __m256i quads = _mm256_madd_epi16(pairs, _mm256_set1_epi32(0x00010064));
+            const __m256i packed = _mm256_packs_epi32(quads, quads);
+            const __m256i octets = _mm256_madd_epi16(packed, _mm256_set1_epi32(0x00012710));
+
+            // слова 0, 1 - номер A, слова 4, 5 - номер B
+            keyA = KEY_11_DIGITS | (RU_PREFIX
+                + static_cast<uint64_t>(static_cast<uint32_t>(_mm256_extract_epi32(octets, 0))) * 100000000ULL
+                + static_cast<uint32_t>(_mm256_extract_epi32(octets, 1)));
+            keyB = KEY_11_DIGITS | (RU_PREFIX
+                + static_cast<uint64_t>(static_cast<uint32_t>(_mm256_extract_epi32(octets, 4))) * 100000000ULL
+                + static_cast<uint32_t>(_mm256_extract_epi32(octets, 5)));
+        }
+
+        store(keys, valid, i, okA, keyA);
+        store(keys, valid, i + 1, okB, keyB);
+        validCount += okA + okB;
+    }
+    if (i < count) {
+        uint64_t key = 0;
+        bool ok = scan_ssse3(data + offsets[i], offsets[i + 1] - offsets[i], end, key);
+        store(keys, valid, i, ok, key);
+        validCount += ok;
+    }
+    return validCount;
+}
+
+static PhoneBatch::Kernel detect_kernel() {
+#if defined(__GNUC__)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) return PhoneBatch::Kernel::AVX2;
+    if (__builtin_cpu_supports("ssse3")) return PhoneBatch::Kernel::SSSE3;
+#elif defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    const int maxLeaf = info[0];
+    __cpuid(info, 1);
+    const bool ssse3 = (info[2] & (1 << 9)) != 0;
+    // AVX2 можно использовать, только если ОС сохраняет регистры ymm (OSXSAVE + XCR0)
+    const bool osAvx = (info[2] & (1 << 27)) && (info[2] & (1 << 28)) && (_xgetbv(0) & 6) == 6;
+    if (osAvx && maxLeaf >= 7) {
+        __cpuidex(info, 7, 0);
+        if (info[1] & (1 << 5)) return PhoneBatch::Kernel::AVX2;
+    }
+    if (ssse3) return PhoneBatch::Kernel::SSSE3;
+#endif
+    return PhoneBatch::Kernel::Scalar;
+}
+
+#endif // PHONEBATCH_X86
+
+PhoneBatch::Kernel PhoneBatch::best_kernel() {
+#ifdef PHONEBATCH_X86
+    static const Kernel kernel = detect_kernel();
+    return kernel;
+#else
+    return Kernel::Scalar;
+#endif
+}
+
+const char* PhoneBatch::kernel_name(Kernel kernel) {
+    switch (kernel) {
+        case Kernel::SSSE3: return "ssse3";
+        case Kernel::AVX2: return "avx2";
+        default: return "scalar";
+    }
+}
+
+size_t PhoneBatch::normalize(const char* data, const size_t* offsets, size_t count,
+                             uint64_t* keys, uint64_t* valid) {
+    return normalize(data, offsets, count, keys, valid, best_kernel());
+}
+
+size_t PhoneBatch::normalize(const char* data, const size_t* offsets, size_t count,
+                             uint64_t* keys, uint64_t* valid, Kernel kernel) {
+    memset(valid, 0, (count + 63) / 64 * sizeof(uint64_t));
+
+    // ядро, которое этот процессор не поддерживает, не вызываем
+    if (static_cast<int>(kernel) > static_cast<int>(best_kernel())) kernel = best_kernel();
+
+#ifdef PHONEBATCH_X86
+    if (kernel == Kernel::AVX2) return normalize_avx2(data, offsets, count, keys, valid);
+    if (kernel == Kernel::SSSE3) return normalize_ssse3(data, offsets, count, keys, valid);
+#endif
+
+    size_t validCount = 0;
+    for (size_t i = 0; i < count; ++i) {
+        uint64_t key = 0;
+        bool ok = scan_scalar(data + offsets[i], offsets[i + 1] - offsets[i], key);
+        store(keys, valid, i, ok, key);
+        validCount += ok;
+    }
+    return validCount;
+}
+
+size_t PhoneBatch::normalize(const vector<string>& numbers, vector<uint64_t>& keys, vector<uint64_t>& valid) {
+    size_t total = 0;
+    for (const auto& number : numbers) total += number.size();
+
+    string column;
+    column.reserve(total);
+    vector<size_t> offsets;
+    offsets.reserve(numbers.size() + 1);
+    offsets.push_back(0);
+    for (const auto& number : numbers) {
+        column += number;
+        offsets.push_back(column.size());
+    }
+
+    keys.assign(numbers.size(), 0);
+    valid.assign((numbers.size() + 63) / 64, 0);
+    if (numbers.empty()) return 0;
+    return normalize(column.data(), offsets.data(), numbers.size(), keys.data(), valid.data());
+}
@@ -0,0 +1,76 @@
+#include "PhoneIndex.h"
+#include <algorithm>
+
+// 10^n для n = 0..15
+static uint64_t power_of_ten(size_t n) {
+    uint64_t p = 1;
+    while (n--) p *= 10;
+    return p;
+}
+
+uint64_t PhoneIndex::order_key(const string& digits) {
+    size_t len = min(digits.size(), ORDER_DIGITS);
+    uint64_t value = 0;
+    for (size_t i = 0; i < len; ++i)
+        value = value * 10 + static_cast<uint64_t>(digits[i] - '0');
+    value *= power_of_ten(ORDER_DIGITS - len);
+    return (value << 4) | len;
+}
+
+const vector<size_t>& PhoneIndex::find(uint64_t key) const {
+    static const vector<size_t> empty;
+    auto it = m_slots.find(key);
+    return it == m_slots.end() ? empty : it->second;
+}
+
+vector<size_t> PhoneIndex::findPrefix(const string& digits, size_t limit) const {
+    vector<size_t> result;
+
+    // из запроса берём только цифры и приводим начало так же, как normalized()
+    string prefix;
+    for (char c : digits) {
+        if (c >= '0' && c <= '9') prefix += c;
+    }
+    if (prefix.empty() || prefix.size() > ORDER_DIGITS || limit == 0) return result;
+    if (prefix[0] == '8') prefix[0] = '7';
+
+    // номера с этим началом лежат в [prefix000..., (prefix+1)000...)
+    uint64_t low = order_key(prefix) >> 4;
+    uint64_t high = low + power_of_ten(ORDER_DIGITS - prefix.size());
+
+    for (auto it = m_ordered.lower_bound({low << 4, 0});
+         it != m_ordered.end() && (it->first >> 4) < high && result.size() < limit; ++it) {
+        // у контакта может быть несколько подходящих номеров - слот выдаём один раз
+        if (std::find(result.begin(), result.end(), it->second) == result.end())
+            result.push_back(it->second);
+    }
+    return result;
+}
+
+void PhoneIndex::insert(const PhoneNumber& phone, size_t slot) {
+    uint64_t key = phone.normalized_key();
+    if (key == 0) return; // пустой номер не индексируем
+
+    vector<size_t>& slots = m_slots[key];
+    // один и тот же номер дважды у одного контакта - слот записываем один раз
+    if (std::find(slots.begin(), slots.end(), slot) == slots.end())
+        slots.push_back(slot);
+
+    m_ordered.insert({order_key(phone.normalized()), slot});
+}
+
+void PhoneIndex::erase(const PhoneNumber& phone, size_t slot) {
+    auto it = m_slots.find(phone.normalized_key());
+    if (it == m_slots.end()) return;
+
+    vector<size_t>& slots = it->second;
+    slots.erase(remove(slots.begin(), slots.end(), slot), slots.end());
+    if (slots.empty()) m_slots.erase(it);
+
+    m_ordered.erase({order_key(phone.normalized()), slot});
+}
+
+void PhoneIndex::clear() {
+    m_slots.clear();
+    m_ordered.clear();
+}
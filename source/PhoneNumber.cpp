@@ -1,5 +1,6 @@
 #include "PhoneNumber.h"
 #include "Validators.h"
+#include "Log.h"
 #include <iostream>
 #include <string>
 #include <regex>
@@ -9,12 +10,113 @@ using json = nlohmann::json;
 using namespace std;
 
 
+static const uint64_t RU_PREFIX = 70000000000ULL; // 7 и десять нулей
+static const int KEY_LENGTH_SHIFT = 56;
+static const uint64_t KEY_VALUE_MASK = (1ULL << KEY_LENGTH_SHIFT) - 1;
+static const size_t KEY_MAX_DIGITS = 15;
+
+// Нормализация строки посимвольно — оставить только цифры, привести к 7XXXXXXXXXX
+static string normalize_text(const string& number) {
+    string clean;
+    // Оставляем только цифры
+    for (char c : number) {
+        if (c >= '0' && c <= '9')  // Простая проверка на цифру
+            clean += c;
+    }
+
+    // Приведение к международному формату (только цифры)
+    if (clean.size() > 0) {
+        if (clean[0] == '8') {
+            // Заменяем 8 на 7 для кода России
+            clean[0] = '7';
+        } else if (clean[0] != '7') {
+            // Если номер не начинается с 7 или 8, добавляем код России
+            if (clean.size() == 10)
+                clean = "7" + clean;
+        }
+    }
+    return clean;
+}
+
 PhoneNumber::PhoneNumber(const string& number, PhoneType type)
-    : number(number), type(type) {}
+    : type(type)
+{
+    assign(number);
+}
+
+PhoneNumber::PhoneNumber(const PhoneNumber& copy)
+    : key(copy.key),
+      raw(copy.raw ? make_unique<string>(*copy.raw) : nullptr),
+      type(copy.type),
+      format(copy.format) {}
+
+PhoneNumber& PhoneNumber::operator=(const PhoneNumber& copy) {
+    if (this != &copy) {
+        key = copy.key;
+        raw = copy.raw ? make_unique<string>(*copy.raw) : nullptr;
+        type = copy.type;
+        format = copy.format;
+    }
+    return *this;
+}
+
+// Ключ нормализованного номера - те же правила, что в normalize_text, но без строк
+uint64_t PhoneNumber::key_of(const string& number) {
+    uint64_t value = 0;
+    uint64_t topDigit = 1;   // 10^(len-1)
+    size_t len = 0;
+    char first = 0;
+
+    for (char c : number) {
+        if (c < '0' || c > '9') continue;
+        if (len == 0) first = c;
+        else if (len < KEY_MAX_DIGITS) topDigit *= 10;
+        if (len < KEY_MAX_DIGITS) value = value * 10 + static_cast<uint64_t>(c - '0');
+        ++len;
+    }
+
+    if (len > KEY_MAX_DIGITS) {
+        // слишком длинный для упаковки - хэш нормализованной строки
+        return KEY_HASHED | (std::hash<string>()(normalize_text(number)) & KEY_VALUE_MASK);
+    }
+
+    if (first == '8') {
+        value -= topDigit;             // 8 -> 7 в старшем разряде
+    } else if (len == 10 && first != '7') {
+        value += 7 * topDigit * 10;    // дописываем код России
+        len = 11;
+    }
+    return (static_cast<uint64_t>(len) << KEY_LENGTH_SHIFT) | value;
+}
+
+// Разбор записи номера: ключ считается всегда, текст хранится только у нестандартных записей
+void PhoneNumber::assign(const string& number) {
+    key = key_of(number);
+
+    bool plain8 = number.size() == 11 && number[0] == '8';
+    bool plus7 = number.size() == 12 && number[0] == '+' && number[1] == '7';
+    bool allDigits = plain8 || plus7;
+    for (size_t i = plus7 ? 2 : 1; allDigits && i < number.size(); ++i) {
+        if (number[i] < '0' || number[i] > '9') allDigits = false;
+    }
+
+    if (allDigits) {
+        format = plus7 ? Format::Plus7 : Format::Plain8;
+        raw.reset();
+    } else {
+        format = Format::Raw;
+        raw = number.empty() ? nullptr : make_unique<string>(number);
+    }
+}
 
 // Геттеры
 string PhoneNumber::get_number() const {
-    return number;
+    if (format == Format::Raw) return raw ? *raw : string();
+
+    char buf[16];
+    snprintf(buf, sizeof(buf), "%s%010llu", format == Format::Plus7 ? "+7" : "8",
+             static_cast<unsigned long long>((key & KEY_VALUE_MASK) - RU_PREFIX));
+    return buf;
 }
 
 PhoneType PhoneNumber::get_type() const {
@@ -31,11 +133,12 @@ string PhoneNumber::type_to_string() const {
 }
 
 bool PhoneNumber::set_number(const string& newNumber) {
+    const string number = get_number();
     if (validate(number)) {
-        number = newNumber;
+        assign(newNumber);
         return true;
     }
-    cerr << "[PhoneNumber] Invalid number: " << number << endl;
+    LOG_WARNING("[PhoneNumber] Invalid number: " << number);
     return false;
 }
 
@@ -45,29 +148,21 @@ void PhoneNumber::set_type(PhoneType newType) {
 
 // Нормализация — оставить только цифры, привести к 7XXXXXXXXXX
 string PhoneNumber::normalized() const {
-    string clean;
-    // Оставляем только цифры
-    for (char c : number) {
-        if (c >= '0' && c <= '9')  // Простая проверка на цифру
-            clean += c;
-    }
+    if (key & KEY_HASHED) return normalize_text(get_number());
 
-    // Приведение к международному формату (только цифры)
-    if (clean.size() > 0) {
-        if (clean[0] == '8') {
-            // Заменяем 8 на 7 для кода России
-            clean[0] = '7';
-        } else if (clean[0] != '7') {
-            // Если номер не начинается с 7 или 8, добавляем код России
-            if (clean.size() == 10)
-                clean = "7" + clean;
-        }
-    }
-    return clean;
+    // нормализованный номер уже лежит в ключе - просто печатаем его нужной длины
+    int len = static_cast<int>((key >> KEY_LENGTH_SHIFT) & 0xF);
+    if (len == 0) return "";
+
+    char buf[24];
+    snprintf(buf, sizeof(buf), "%0*llu", len, static_cast<unsigned long long>(key & KEY_VALUE_MASK));
+    return buf;
 }
 
 bool PhoneNumber::is_valid() const {
-    return validate(number);
+    // 8XXXXXXXXXX и +7XXXXXXXXXX валидны всегда - упакованный номер не нужно проверять заново
+    if (format != Format::Raw) return true;
+    return validate(get_number());
 }
 
 // Простая обёртка над Validators
@@ -78,11 +173,20 @@ bool PhoneNumber::validate(const string& number) {
 // Сериализация в JSON
 json PhoneNumber::toJsonObj() const {
     json j;
-    j["number"] = number;
+    j["number"] = get_number();
     j["type"] = static_cast<int>(type);
     return j;
 }
 
+void PhoneNumber::writeJson(JsonWriter& writer) const {
+    writer.begin_object();
+    writer.key("number");
+    writer.value(get_number());
+    writer.key("type");
+    writer.value(static_cast<int64_t>(type));
+    writer.end_object();
+}
+
 string PhoneNumber::toJson() const {
     return toJsonObj().dump();
 }
@@ -123,13 +227,23 @@ PhoneNumber PhoneNumber::fromJson(const string& jsonStr) {
 }
 
 string PhoneNumber::toString() const {
-    return type_to_string() + ": " + number;
+    return type_to_string() + ": " + get_number();
 }
 
 bool PhoneNumber::operator==(const PhoneNumber& other) const {
-    return normalized() == other.normalized();
+    // ключи равны <=> нормализованные номера равны (кроме редких длинных номеров с хэшем)
+    if ((key & KEY_HASHED) && key == other.key)
+        return normalized() == other.normalized();
+    return key == other.key;
 }
 
 bool PhoneNumber::operator!=(const PhoneNumber& other) const {
     return !(*this == other);
 }
+
+bool PhoneNumber::operator<(const PhoneNumber& other) const {
+    if (key != other.key) return key < other.key;
+    // одинаковый хэш ещё не значит одинаковый номер - решает строка, иначе < и == расходятся
+    if (key & KEY_HASHED) return normalized() < other.normalized();
+    return false;
+}
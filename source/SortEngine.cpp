@@ -0,0 +1,114 @@
+#include "SortEngine.h"
+#include <algorithm>
+#include <cstring>
+
+// Байты одного поля ключа (для убывания - инвертированные)
+static void append_string(string& out, const string& value, bool ascending) {
+    const char flip = ascending ? 0 : static_cast<char>(0xFF);
+    for (char c : value) {
+        out += static_cast<char>(c ^ flip);
+        if (c == 0) out += static_cast<char>(0xFF ^ flip);
+    }
+    out += static_cast<char>(0x00 ^ flip);
+    out += static_cast<char>(0x01 ^ flip);
+}
+
+static void append_uint32(string& out, uint32_t value, bool ascending) {
+    if (!ascending) value = ~value;
+    for (int shift = 24; shift >= 0; shift -= 8) out += static_cast<char>((value >> shift) & 0xFF);
+}
+
+void SortEngine::append_key(string& out, const Contact& contact, const vector<Key>& keys) {
+    for (const Key& key : keys) {
+        switch (key.field) {
+            case SortField::FirstName: append_string(out, contact.ref_firstName(), key.ascending); break;
+            case SortField::LastName:  append_string(out, contact.ref_lastName(), key.ascending); break;
+            case SortField::Email:     append_string(out, contact.ref_email(), key.ascending); break;
+            case SortField::BirthDate: append_uint32(out, contact.ref_birthDate().sort_key(), key.ascending); break;
+        }
+    }
+}
+
+void SortEngine::load_prefix(Item& item, const string& keys, size_t depth) {
+    // за концом ключа - нули. Ключи не бывают префиксами друг друга (в конце номер контакта),
+    // поэтому дополнение нулями не склеивает разные ключи
+    uint64_t prefix = 0;
+    const unsigned char* data = reinterpret_cast<const unsigned char*>(keys.data()) + item.offset;
+    for (size_t i = 0; i < 8; ++i) {
+        prefix <<= 8;
+        if (depth + i < item.length) prefix |= data[depth + i];
+    }
+    item.prefix = prefix;
+}
+
+// Поразрядная сортировка items[0..count) по байту byte (0..7) текущего префикса на глубине depth
+void SortEngine::radix_sort(Item* items, Item* buffer, size_t count, const string& keys, size_t depth, int byte) {
+    // маленькие группы - обычной сортировкой по оставшейся части ключа
+    if (count <= 32) {
+        const char* data = keys.data();
+        std::sort(items, items + count, [&](const Item& a, const Item& b) {
+            if (a.prefix != b.prefix) return a.prefix < b.prefix;
+            size_t from = depth + 8;
+            size_t lenA = a.length > from ? a.length - from : 0;
+            size_t lenB = b.length > from ? b.length - from : 0;
+            int order = memcmp(data + a.offset + from, data + b.offset + from, min(lenA, lenB));
+            return order != 0 ? order < 0 : lenA < lenB;
+        });
+        return;
+    }
+
+    if (byte == 8) {
+        // префикс исчерпан - все ключи группы совпадают в этих 8 байтах, берём следующие 8
+        depth += 8;
+        byte = 0;
+        for (size_t i = 0; i < count; ++i) load_prefix(items[i], keys, depth);
+    }
+
+    const int shift = 56 - 8 * byte;
+    size_t counts[257] = {};
+    for (size_t i = 0; i < count; ++i) ++counts[((items[i].prefix >> shift) & 0xFF) + 1];
+    for (int b = 0; b < 256; ++b) counts[b + 1] += counts[b];
+
+    // раскладываем по корзинам через буфер, порядок внутри корзины сохраняется
+    size_t next[256];
+    memcpy(next, counts, sizeof(next));
+    for (size_t i = 0; i < count; ++i) buffer[next[(items[i].prefix >> shift) & 0xFF]++] = items[i];
+    memcpy(items, buffer, count * sizeof(Item));
+
+    for (int b = 0; b < 256; ++b) {
+        size_t size = counts[b + 1] - counts[b];
+        if (size > 1) radix_sort(items + counts[b], buffer + counts[b], size, keys, depth, byte + 1);
+    }
+}
+
+vector<size_t> SortEngine::order(const vector<Contact>& contacts, const vector<Key>& keys) {
+    // все ключи подряд в одном буфере; в конце каждого - номер контакта (для устойчивости)
+    string buffer;
+    vector<Item> items(contacts.size());
+    for (size_t i = 0; i < contacts.size(); ++i) {
+        size_t offset = buffer.size();
+        append_key(buffer, contacts[i], keys);
+        append_uint32(buffer, static_cast<uint32_t>(i), true);
+
+        items[i].offset = offset;
+        items[i].length = static_cast<uint32_t>(buffer.size() - offset);
+        items[i].index = static_cast<uint32_t>(i);
+    }
+    for (Item& item : items) load_prefix(item, buffer, 0);
+
+    vector<Item> temp(items.size());
+    if (!items.empty()) radix_sort(items.data(), temp.data(), items.size(), buffer, 0, 0);
+
+    vector<size_t> result(items.size());
+    for (size_t i = 0; i < items.size(); ++i) result[i] = items[i].index;
+    return result;
+}
+
+void SortEngine::sort(vector<Contact>& contacts, const vector<Key>& keys) {
+    vector<size_t> permutation = order(contacts, keys);
+
+    vector<Contact> sorted;
+    sorted.reserve(contacts.size());
+    for (size_t index : permutation) sorted.push_back(std::move(contacts[index]));
+    contacts.swap(sorted);
+}
@@ -0,0 +1,38 @@
+#include "SortedIndex.h"
+#include <algorithm>
+
+int SortedIndex::Less::compare(size_t a, size_t b) const {
+    const Contact& x = (*contacts)[a];
+    const Contact& y = (*contacts)[b];
+
+    int order = 0;
+    switch (field) {
+        case SortField::FirstName: order = x.ref_firstName().compare(y.ref_firstName()); break;
+        case SortField::LastName:  order = x.ref_lastName().compare(y.ref_lastName()); break;
+        case SortField::Email:     order = x.ref_email().compare(y.ref_email()); break;
+        case SortField::BirthDate:
+            order = x.ref_birthDate() < y.ref_birthDate() ? -1
+                  : y.ref_birthDate() < x.ref_birthDate() ? 1 : 0;
+            break;
+    }
+    return order;
+}
+
+bool SortedIndex::Less::operator()(size_t a, size_t b) const {
+    int order = compare(a, b);
+    return order != 0 ? order < 0 : a < b;
+}
+
+vector<size_t> SortedIndex::descending() const {
+    vector<size_t> result(m_slots.rbegin(), m_slots.rend());
+
+    // обратный обход ставит равные по полю в обратном порядке добавления - разворачиваем каждую группу
+    const Less& less = m_slots.key_comp();
+    for (size_t begin = 0; begin < result.size();) {
+        size_t end = begin + 1;
+        while (end < result.size() && less.compare(result[begin], result[end]) == 0) ++end;
+        reverse(result.begin() + static_cast<ptrdiff_t>(begin), result.begin() + static_cast<ptrdiff_t>(end));
+        begin = end;
+    }
+    return result;
+}
@@ -0,0 +1,262 @@
+#include "TextIndex.h"
+#include "NameIndex.h"
+#include <algorithm>
+#include <cmath>
+
+// Вес совпадения в каждом поле: фамилия важнее адреса
+const double TextIndex::FIELD_BOOST[TextIndex::FIELD_COUNT] = {
+    2.0,  // FirstName
+    3.0,  // LastName
+    1.5,  // Patronymic
+    1.0,  // Address
+    1.5   // Email
+};
+
+vector<string> TextIndex::tokenize(const string& text) {
+    vector<string> tokens;
+    string folded = NameIndex::fold(text);
+
+    string current;
+    for (char ch : folded) {
+        unsigned char c = ch;
+        bool wordChar = c >= 0x80 || (c >= 'a' && c <= 'z') || (c >= '0' && c <= '9');
+        if (wordChar) {
+            current += ch;
+        } else if (!current.empty()) {
+            tokens.push_back(std::move(current));
+            current.clear();
+        }
+    }
+    if (!current.empty()) tokens.push_back(std::move(current));
+    return tokens;
+}
+
+uint32_t TextIndex::termId(const string& term) {
+    auto it = m_termIds.find(term);
+    if (it != m_termIds.end()) return it->second;
+
+    uint32_t id;
+    if (!m_freeTermIds.empty()) {
+        id = m_freeTermIds.back();
+        m_freeTermIds.pop_back();
+        m_terms[id] = term;
+    } else {
+        id = static_cast<uint32_t>(m_terms.size());
+        m_terms.push_back(term);
+        m_postings.emplace_back();
+    }
+    m_termIds.emplace(term, id);
+    return id;
+}
+
+void TextIndex::insert(size_t slot, const Contact& contact) {
+    if (slot >= m_used.size()) {
+        m_used.resize(slot + 1, false);
+        m_slotTerms.resize(slot + 1);
+        m_fieldLength.resize(slot + 1);
+    }
+    if (m_used[slot]) erase(slot);
+
+    const string* fields[FIELD_COUNT] = {
+        &contact.ref_firstName(), &contact.ref_lastName(), &contact.ref_patronymic(),
+        &contact.ref_address(), &contact.ref_email()
+    };
+
+    // слово -> число вхождений по полям
+    vector<Posting> counts;
+    vector<uint32_t>& terms = m_slotTerms[slot];
+    terms.clear();
+
+    for (int field = 0; field < FIELD_COUNT; ++field) {
+        vector<string> tokens = tokenize(*fields[field]);
+        m_fieldLength[slot][field] = static_cast<uint16_t>(min<size_t>(tokens.size(), UINT16_MAX));
+        m_totalLength[field] += m_fieldLength[slot][field];
+
+        for (const string& token : tokens) {
+            uint32_t id = termId(token);
+            auto it = find(terms.begin(), terms.end(), id);
+            size_t pos = static_cast<size_t>(it - terms.begin());
+            if (it == terms.end()) {
+                terms.push_back(id);
+                counts.push_back(Posting{slot, {}, true});
+            }
+            uint8_t& tf = counts[pos].tf[field];
+            if (tf < UINT8_MAX) ++tf;
+        }
+    }
+
+    for (size_t i = 0; i < terms.size(); ++i) {
+        PostingList& list = m_postings[terms[i]];
+        auto it = lower_bound(list.items.begin(), list.items.end(), slot,
+                              [](const Posting& p, size_t s) { return p.slot < s; });
+        if (it != list.items.end() && it->slot == slot) {
+            // обновление: запись слота осталась от erase - занимаем её без сдвига
+            *it = counts[i];
+            --list.dead;
+        } else {
+            // новые контакты получают самый большой слот - обычно это просто push_back
+            list.items.insert(it, counts[i]);
+        }
+    }
+
+    m_used[slot] = true;
+    ++m_count;
+}
+
+void TextIndex::erase(size_t slot) {
+    if (slot >= m_used.size() || !m_used[slot]) return;
+
+    for (uint32_t id : m_slotTerms[slot]) {
+        PostingList& list = m_postings[id];
+        auto it = lower_bound(list.items.begin(), list.items.end(), slot,
+                              [](const Posting& p, size_t s) { return p.slot < s; });
+        if (it != list.items.end() && it->slot == slot && it->alive) {
+            it->alive = false;   // только пометка - сдвиг длинного списка был бы O(N)
+            ++list.dead;
+        }
+
+        if (list.alive() == 0) {
+            // слово больше нигде не встречается - номер можно переиспользовать
+            m_termIds.erase(m_terms[id]);
+            string().swap(m_terms[id]);
+            vector<Posting>().swap(list.items);
+            list.dead = 0;
+            m_freeTermIds.push_back(id);
+        } else {
+            compact(list);
+        }
+    }
+    vector<uint32_t>().swap(m_slotTerms[slot]);
+
+    for (int field = 0; field < FIELD_COUNT; ++field) {
+        m_totalLength[field] -= m_fieldLength[slot][field];
+    }
+    m_fieldLength[slot] = {};
+    m_used[slot] = false;
+    --m_count;
+}
+
+void TextIndex::clear() {
+    m_termIds.clear();
+    m_terms.clear();
+    m_postings.clear();
+    m_freeTermIds.clear();
+    m_slotTerms.clear();
+    m_fieldLength.clear();
+    m_used.clear();
+    m_count = 0;
+    for (size_t& total : m_totalLength) total = 0;
+}
+
+void TextIndex::compact(PostingList& list) {
+    if (list.dead < 32 || list.dead < list.alive()) return; // удалённых пока немного
+
+    list.items.erase(remove_if(list.items.begin(), list.items.end(),
+                               [](const Posting& p) { return !p.alive; }),
+                     list.items.end());
+    list.dead = 0;
+}
+
+double TextIndex::fieldWeightedTf(const Posting& posting) const {
+    double tf = 0;
+    for (int field = 0; field < FIELD_COUNT; ++field) {
+        if (posting.tf[field] == 0) continue;
+        double average = static_cast<double>(m_totalLength[field]) / m_count;
+        double norm = 1 - B + B * m_fieldLength[posting.slot][field] / average;
+        tf += FIELD_BOOST[field] * posting.tf[field] / norm;
+    }
+    return tf;
+}
+
+vector<pair<size_t, double>> TextIndex::search(const string& query, size_t k) const {
+    vector<pair<size_t, double>> result;
+    if (k == 0 || m_count == 0) return result;
+
+    // слова запроса, которые есть в индексе
+    struct Term {
+        const vector<Posting>* postings;
+        double idf;
+        double bound;   // больше этого слово к оценке не добавит
+        size_t pos;     // текущая позиция в списке
+    };
+    vector<Term> terms;
+
+    vector<string> tokens = tokenize(query);
+    sort(tokens.begin(), tokens.end());
+    tokens.erase(unique(tokens.begin(), tokens.end()), tokens.end());
+    for (const string& token : tokens) {
+        auto it = m_termIds.find(token);
+        if (it == m_termIds.end()) continue;
+
+        const PostingList& list = m_postings[it->second];
+        double df = static_cast<double>(list.alive());
+        double idf = log(1 + (m_count - df + 0.5) / (df + 0.5));
+        terms.push_back({&list.items, idf, idf * (K1 + 1), 0});
+    }
+    if (terms.empty()) return result;
+
+    // MaxScore: слова по возрастанию вклада; bounds[i] - наибольший вклад слов 0..i вместе
+    sort(terms.begin(), terms.end(), [](const Term& a, const Term& b) { return a.bound < b.bound; });
+    vector<double> bounds(terms.size());
+    for (size_t i = 0; i < terms.size(); ++i) bounds[i] = terms[i].bound + (i ? bounds[i - 1] : 0);
+
+    auto contribution = [&](const Term& term, const Posting& posting) {
+        double tf = fieldWeightedTf(posting);
+        return term.idf * tf * (K1 + 1) / (K1 + tf);
+    };
+
+    // куча худших из лучших: наверху слот, который вылетит первым
+    auto better = [](const pair<size_t, double>& a, const pair<size_t, double>& b) {
+        return a.second != b.second ? a.second > b.second : a.first < b.first;
+    };
+    double threshold = -1;   // оценка k-го результата (пока k не набралось - любая подходит)
+    size_t essential = 0;    // слова до essential сами по себе до порога не дотягивают
+
+    while (true) {
+        // следующий слот - наименьший среди списков "важных" слов (удалённые записи пропускаем)
+        size_t slot = SIZE_MAX;
+        for (size_t i = essential; i < terms.size(); ++i) {
+            Term& term = terms[i];
+            while (term.pos < term.postings->size() && !(*term.postings)[term.pos].alive) ++term.pos;
+            if (term.pos < term.postings->size()) slot = min(slot, (*term.postings)[term.pos].slot);
+        }
+        if (slot == SIZE_MAX) break;
+
+        double score = 0;
+        for (size_t i = essential; i < terms.size(); ++i) {
+            Term& term = terms[i];
+            if (term.pos < term.postings->size() && (*term.postings)[term.pos].slot == slot) {
+                score += contribution(term, (*term.postings)[term.pos]);
+                ++term.pos;
+            }
+        }
+
+        // остальные слова досчитываем, только пока слот ещё может пройти порог
+        for (size_t i = essential; i-- > 0;) {
+            if (score + bounds[i] <= threshold) break;
+
+            Term& term = terms[i];
+            auto begin = term.postings->begin() + static_cast<ptrdiff_t>(term.pos);
+            auto it = lower_bound(begin, term.postings->end(), slot,
+                                  [](const Posting& p, size_t s) { return p.slot < s; });
+            term.pos = static_cast<size_t>(it - term.postings->begin());
+            if (it != term.postings->end() && it->slot == slot && it->alive) score += contribution(term, *it);
+        }
+
+        if (score <= threshold) continue;
+
+        result.push_back({slot, score});
+        push_heap(result.begin(), result.end(), better);
+        if (result.size() > k) {
+            pop_heap(result.begin(), result.end(), better);
+            result.pop_back();
+        }
+        if (result.size() == k) {
+            threshold = result.front().second;
+            while (essential < terms.size() && bounds[essential] <= threshold) ++essential;
+        }
+    }
+
+    sort_heap(result.begin(), result.end(), better);
+    return result;
+}
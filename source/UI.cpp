@@ -1,6 +1,7 @@
 #include <iostream>
 #include <limits>
 #include <algorithm>
+#include <sstream>
 #include "UI.h"
 
 using namespace std;
@@ -42,6 +43,7 @@ void sortContacts(ContactManager& manager) {
     cout << "2. Last Name\n";
     cout << "3. Email\n";
     cout << "4. Birth Date\n";
+    cout << "5. Several Fields\n";
     cout << "0. Back to Menu\n";
     cout << "> ";
 
@@ -50,81 +52,75 @@ void sortContacts(ContactManager& manager) {
     clearInput();
 
     if (field == 0) return;
-    if (field < 1 || field > 4) {
+    if (field < 1 || field > 5) {
         cout << "Invalid choice!\n";
         return;
     }
 
-    cout << "\nSort order:\n";
-    cout << "1. Ascending (A-Z, Oldest first)\n";
-    cout << "2. Descending (Z-A, Newest first)\n";
-    cout << "> ";
-
-    int direction;
-    cin >> direction;
-    clearInput();
-
-    if (direction != 1 && direction != 2) {
-        cout << "Invalid order choice!\n";
-        return;
-    }
+    const SortField fields[] = { SortField::FirstName, SortField::LastName, SortField::Email, SortField::BirthDate };
+    const char* fieldNames[] = { "First Name", "Last Name", "Email", "Birth Date" };
 
-    bool ascending = (direction == 1);
-    auto contacts = manager.getAllContacts();
-    
+    vector<SortEngine::Key> keys;
     string fieldName, orderName;
-    
-    switch (field) {
-        case 1:
-            sort(contacts.begin(), contacts.end(), 
-                 [ascending](const Contact& a, const Contact& b) {
-                     return ascending ? (a.get_firstName() < b.get_firstName()) 
-                                     : (a.get_firstName() > b.get_firstName());
-                 });
-            fieldName = "First Name";
-            break;
-        case 2:
-            sort(contacts.begin(), contacts.end(), 
-                 [ascending](const Contact& a, const Contact& b) {
-                     return ascending ? (a.get_lastName() < b.get_lastName()) 
-                                     : (a.get_lastName() > b.get_lastName());
-                 });
-            fieldName = "Last Name";
-            break;
-        case 3:
-            sort(contacts.begin(), contacts.end(), 
-                 [ascending](const Contact& a, const Contact& b) {
-                     return ascending ? (a.get_email() < b.get_email()) 
-                                     : (a.get_email() > b.get_email());
-                 });
-            fieldName = "Email";
-            break;
-        case 4:
-            sort(contacts.begin(), contacts.end(), 
-                 [ascending](const Contact& a, const Contact& b) {
-                     return ascending ? (a.get_birthDate() < b.get_birthDate()) 
-                                     : (a.get_birthDate() > b.get_birthDate());
-                 });
-            fieldName = "Birth Date";
-            break;
-    }
-    
-    orderName = ascending ? "Ascending" : "Descending";
 
-    // СОХРАНЕНИЕ ОТСОРТИРОВАННЫХ КОНТАКТОВ В ФАЙЛ
-    if (manager.updateAllContacts(contacts)) {
-        cout << "Contacts sorted and saved to file!\n";
+    if (field == 5) {
+        // например "2 1 4-": фамилия, потом имя, потом дата рождения по убыванию
+        cout << "\nEnter fields in priority order (1-4, add '-' for descending), e.g. 2 1 4-\n> ";
+        string line;
+        getline(cin, line);
+
+        istringstream input(line);
+        string token;
+        while (input >> token) {
+            bool ascending = token.back() != '-';
+            int number = token[0] - '0';
+            if (token.size() > (ascending ? 1u : 2u) || number < 1 || number > 4) {
+                cout << "Invalid field: " << token << "\n";
+                return;
+            }
+            keys.push_back({fields[number - 1], ascending});
+
+            if (!fieldName.empty()) fieldName += ", ";
+            fieldName += fieldNames[number - 1];
+            fieldName += ascending ? " +" : " -";
+        }
+        if (keys.empty()) {
+            cout << "No fields entered!\n";
+            return;
+        }
+        orderName = "Multiple Keys";
     } else {
-        cout << "Error: Failed to save sorted contacts!\n";
+        cout << "\nSort order:\n";
+        cout << "1. Ascending (A-Z, Oldest first)\n";
+        cout << "2. Descending (Z-A, Newest first)\n";
+        cout << "> ";
+
+        int direction;
+        cin >> direction;
+        clearInput();
+
+        if (direction != 1 && direction != 2) {
+            cout << "Invalid order choice!\n";
+            return;
+        }
+
+        bool ascending = (direction == 1);
+        keys.push_back({fields[field - 1], ascending});
+        fieldName = fieldNames[field - 1];
+        orderName = ascending ? "Ascending" : "Descending";
     }
-    // all
+
+    // по одному полю хранилище уже держит контакты упорядоченными - просто читаем нужный порядок;
+    // по нескольким - один раз строятся ключи сравнения и сортируются поразрядно.
+    // В обоих случаях файл не перезаписывается
+    auto contacts = manager.getSortedContacts(keys);
 
     cout << "\n___ Contacts Sorted by " << fieldName << " (" << orderName << ") ___\n";
     for (size_t i = 0; i < contacts.size(); ++i) {
         const auto& c = contacts[i];
-        cout << i+1 << ". " << c.get_firstName() << " " << c.get_lastName()
-             << " | Email: " << c.get_email() 
-             << " | Birth: " << (c.get_birthDate().empty() ? "Not set" : c.get_birthDate()) << "\n";
+        cout << i+1 << ". " << c.ref_firstName() << " " << c.ref_lastName()
+             << " | Email: " << c.ref_email() 
+             << " | Birth: " << (!c.has_birthDate() ? "Not set" : c.get_birthDate()) << "\n";
     }
     
     cout << "\nTotal contacts: " << contacts.size() << "\n";
@@ -232,13 +228,14 @@ void editContact(ContactManager& manager) {
             }
             case 8: {
                 if (contact.is_valid()) {
-                    if (manager.updateContact(contact)) {
+                    if (manager.updateContact(std::move(contact))) {
                         cout << "Contact updated successfully!\n";
                     } else {
                         cout << "Failed to update contact!\n";
                     }
                     return;
                 } else {
+                    cerr << contact.validation_error() << "\n";
                     cout << "Contact data is invalid! Please fix errors before saving.\n";
                 }
                 break;
@@ -425,13 +422,19 @@ void addContact(ContactManager& manager) {
         cin.ignore(); // убираем символ перевода строки
 
         PhoneType type = static_cast<PhoneType>(t);
-        c.addPhone(PhoneNumber(input, type));
+        PhoneNumber phone(input, type);
+        if (!phone.is_valid()) {
+            cerr << "Invalid phone number!\n";
+            continue;
+        }
+        c.addPhone(phone);
     }
 
     if (c.is_valid()) {
-        manager.addContact(c);
+        manager.addContact(std::move(c));
         cout << "Contact added!\n";
     } else {
+        cerr << c.validation_error() << "\n";
         cerr << "The contact was not deleted or added.\n";
     }
 }
@@ -448,24 +451,24 @@ void viewContacts(const ContactManager& manager) {
     for (size_t i = 0; i < contacts.size(); ++i) {
         const auto& c = contacts[i];
         cout << "___ Contact " << i+1 << " ___\n";
-        cout << "Name: " << c.get_firstName();
-        if (!c.get_patronymic().empty()) {
-            cout << " " << c.get_patronymic();
+        cout << "Name: " << c.ref_firstName();
+        if (!c.ref_patronymic().empty()) {
+            cout << " " << c.ref_patronymic();
         }
-        cout << " " << c.get_lastName();
+        cout << " " << c.ref_lastName();
         cout << "\n";
         
-        if (!c.get_birthDate().empty()) {
+        if (c.has_birthDate()) {
             cout << "Birth Date: " << c.get_birthDate() << "\n";
         }
         
-        cout << "Email: " << c.get_email() << "\n";
+        cout << "Email: " << c.ref_email() << "\n";
         
-        if (!c.get_address().empty()) {
-            cout << "Address: " << c.get_address() << "\n";
+        if (!c.ref_address().empty()) {
+            cout << "Address: " << c.ref_address() << "\n";
         }
         
-        auto phones = c.get_phones();
+        const auto& phones = c.ref_phones();
         if (!phones.empty()) {
             cout << "Phones:\n";
             for (const auto& phone : phones) {
@@ -482,6 +485,9 @@ void searchContacts(const ContactManager& manager) {
     cout << "1. Search by Name\n";
     cout << "2. Search by Email\n";
     cout << "3. Search by Phone\n";
+    cout << "4. Search Everywhere\n";
+    cout << "5. Upcoming Birthdays\n";
+    cout << "6. Search by Age\n";
     cout << "0. Back\n";
     cout << "> ";
 
@@ -496,27 +502,45 @@ void searchContacts(const ContactManager& manager) {
         case 1: {
             cout << "Enter name to search: ";
             getline(cin, query);
-            results = manager.searchByName(query);
+            results = manager.searchByName(query, true); // латиницей тоже находит кириллические имена
+            if (results.empty()) {
+                // возможно, опечатка - показываем похожие имена
+                results = manager.fuzzySearch(query, 2, 10);
+                if (!results.empty()) cout << "No exact matches. Similar names:\n";
+            }
             break;
         }
         case 2: {
-            cout << "Enter email to search: ";
+            cout << "Enter email to search (or @domain for everyone at the domain): ";
             getline(cin, query);
+            if (!query.empty() && query[0] == '@') {
+                results = manager.findByEmailSuffix(query);
+                break;
+            }
             auto allContacts = manager.getAllContacts();
             copy_if(allContacts.begin(), allContacts.end(), back_inserter(results),
                    [&](const Contact& c) {
-                       return c.get_email().find(query) != string::npos;
+                       return c.ref_email().find(query) != string::npos;
                    });
             break;
         }
         case 3: {
             cout << "Enter phone to search: ";
             getline(cin, query);
+
+            // сначала точное совпадение номера в любой записи (+7... и 8... - один номер)
+            results = manager.findByPhone(query);
+            if (!results.empty()) break;
+
+            // потом по началу номера (первые 20 совпадений)
+            results = manager.findByPhonePrefix(query, 20);
+            if (!results.empty()) break;
+
+            // иначе ищем как подстроку
             auto allContacts = manager.getAllContacts();
             copy_if(allContacts.begin(), allContacts.end(), back_inserter(results),
                    [&](const Contact& c) {
-                       auto phones = c.get_phones();
-                       for (const auto& phone : phones) {
+                       for (const auto& phone : c.ref_phones()) {
                            if (phone.get_number().find(query) != string::npos) {
                                return true;
                            }
@@ -525,6 +549,28 @@ void searchContacts(const ContactManager& manager) {
                    });
             break;
         }
+        case 4: {
+            cout << "Enter words to search (name, address, email): ";
+            getline(cin, query);
+            results = manager.searchText(query); // самые подходящие - первыми
+            break;
+        }
+        case 5: {
+            int days;
+            cout << "Birthdays within how many days: ";
+            cin >> days;
+            clearInput();
+            results = manager.upcomingBirthdays(days); // ближайшие - первыми
+            break;
+        }
+        case 6: {
+            int minAge, maxAge;
+            cout << "Enter age range (from to): ";
+            cin >> minAge >> maxAge;
+            clearInput();
+            results = manager.findByAge(minAge, maxAge);
+            break;
+        }
         case 0:
             return;
         default:
@@ -538,9 +584,9 @@ void searchContacts(const ContactManager& manager) {
         cout << "\n___ Search Results (" << results.size() << " found) ___\n";
         for (size_t i = 0; i < results.size(); ++i) {
             const auto& c = results[i];
-            cout << i+1 << ". " << c.get_firstName() << " " << c.get_lastName()
-                 << " | Email: " << c.get_email() << " | Phones: ";
-            for (const auto& pn : c.get_phones()) {
+            cout << i+1 << ". " << c.ref_firstName() << " " << c.ref_lastName()
+                 << " | Email: " << c.ref_email() << " | Phones: ";
+            for (const auto& pn : c.ref_phones()) {
                 cout << pn.get_number() << " ";
             }
             cout << "\n";
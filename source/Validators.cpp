@@ -1,33 +1,19 @@
 #include "Validators.h"
+#include "Date.h"
 #include <iostream>
 #include <string>
 #include <cctype>
 #include <ctime>
-#include <vector>
-#include <locale>
-#include <codecvt>
-#include <regex>
 
 using namespace std;
-using std::isspace;
 
-// Вспомогательная функция для удаления пробелов по краям
-static string trim(const string& str) {
-    ::std::size_t start = str.find_first_not_of(" \t\n\r");
-    if (start == string::npos) return "";
-    
-    ::std::size_t end = str.find_last_not_of(" \t\n\r");
-    return str.substr(start, end - start + 1);
-}
-
-// Удаление всех пробелов
-static string remove_spaces(const string& s) {
-    string out;
-    for (char c : s) {
-        if (!std::isspace(static_cast<unsigned char>(c)))
-            out += c;
-    }
-    return out;
+// Границы строки без пробелов по краям (пробел, \t, \n, \r): [begin, end)
+static void trim_bounds(string_view str, size_t& begin, size_t& end) {
+    begin = 0;
+    end = str.size();
+    auto is_trimmed = [](char c) { return c == ' ' || c == '\t' || c == '\n' || c == '\r'; };
+    while (begin < end && is_trimmed(str[begin])) ++begin;
+    while (end > begin && is_trimmed(str[end - 1])) --end;
 }
 
 // Проверка буквы
@@ -44,30 +30,20 @@ static bool isDigit(unsigned char c) {
     return c >= '0' && c <= '9';
 }
 
-// Проверка буквенно-цифрового символа (аналог isalnum для Unicode)
-static bool isAlnum(char32_t c) {
-    return isLetter(c) || isDigit(c);
-}
-
 // Имя / Фамилия / Отчество
-bool Validators::validate_name(const string& name) {
-    // Удаляем незначимые пробелы перед и после
-    string name_trimmed = trim(name);
-    if (name_trimmed.empty()) return false;
+bool Validators::validate_name(string_view name) {
+    // Незначимые пробелы перед и после не учитываем
+    size_t begin, end;
+    trim_bounds(name, begin, end);
+    if (begin == end) return false;
 
-    // Не может начинаться или заканчиваться на дефис
-    if (name_trimmed.front() == '-' || name_trimmed.back() == '-')
+    // Должен начинаться на букву (значит, и не на дефис) и не заканчиваться на дефис
+    if (!isLetter(name[begin]) || name[end - 1] == '-')
         return false;
 
-    // Должен начинаться на букву
-    if (!isLetter(name_trimmed.front()))
-        return false;
-
-    // Проверяем все символы
-    for (::std::size_t i = 0; i < name_trimmed.size(); i++) {
-        unsigned char c = name_trimmed[i];
-        
-        // Допустимы: буквы, цифры, дефис, пробел
+    // Допустимы: буквы, цифры, дефис, пробел
+    for (size_t i = begin; i < end; i++) {
+        unsigned char c = name[i];
         if (!(isLetter(c) || isDigit(c) || c == '-' || c == ' '))
             return false;
     }
@@ -75,63 +51,127 @@ bool Validators::validate_name(const string& name) {
     return true;
 }
 
-// Email
-bool Validators::validate_email(const string& newEmail) {
-    string email = remove_spaces(trim(newEmail));
-    if (email.empty()) return false;
-    
-    static const regex email_regex(
-        R"(^[a-zA-Z0-9._%+-]+@[a-zA-Z0-9.-]+\.[a-zA-Z]{2,}$)"
-    );
+// Email - конечный автомат вместо регулярного выражения
+// ^[a-zA-Z0-9._%+-]+@[a-zA-Z0-9.-]+\.[a-zA-Z]{2,}$
+namespace {
 
-    return regex_match(email, email_regex);
-}
+// Классы символов
+enum EmailClass : unsigned char {
+    E_LETTER,   // a-z A-Z
+    E_DIGIT,    // 0-9
+    E_LOCAL,    // _ % + - допустимы только до @
+    E_DOT,
+    E_HYPHEN,
+    E_AT,
+    E_SPACE,    // пробельные символы пропускаются (раньше удалялись перед проверкой)
+    E_OTHER,
+    E_CLASSES
+};
 
-// Телефон - ИСПРАВЛЕННАЯ ВЕРСИЯ
-bool Validators::validate_phone(const string& phone) {
-    string s = trim(phone);
-    if (s.empty()) return false;
+// Состояния. Домен читается как "что угодно из [a-zA-Z0-9.-]", но помним,
+// сколько букв прошло после последней точки: правильный конец - точка с непустым
+// доменом перед ней и хотя бы две буквы после
+enum EmailState : unsigned char {
+    S_START,        // ничего не прочитано
+    S_LOCAL,        // непустая часть до @
+    S_AT,           // только что прочитан @
+    S_DOMAIN,       // непустой домен, окончание пока не подходит
+    S_DOT,          // точка после непустого домена
+    S_TLD1,         // одна буква после такой точки
+    S_TLD2,         // две и больше букв после неё - допускающее состояние
+    S_REJECT,
+    S_STATES
+};
 
-    string cleaned;
-    bool had_plus = false;
-    
-    // Сохраняем информацию о наличии +
-    if (!s.empty() && s[0] == '+') {
-        had_plus = true;
+struct EmailDfa {
+    unsigned char charClass[256];
+    unsigned char next[S_STATES][E_CLASSES];
+};
+
+constexpr EmailDfa build_email_dfa() {
+    EmailDfa dfa{};
+
+    for (int c = 0; c < 256; ++c) {
+        unsigned char cls = E_OTHER;
+        if ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z')) cls = E_LETTER;
+        else if (c >= '0' && c <= '9') cls = E_DIGIT;
+        else if (c == '_' || c == '%' || c == '+') cls = E_LOCAL;
+        else if (c == '.') cls = E_DOT;
+        else if (c == '-') cls = E_HYPHEN;
+        else if (c == '@') cls = E_AT;
+        else if (c == ' ' || (c >= '\t' && c <= '\r')) cls = E_SPACE;
+        dfa.charClass[c] = cls;
     }
-    
-    // Очищаем от нецифровых символов (кроме + который уже учли)
-    for (char c : s) {
-        if (c == ' ' || c == '-' || c == '(' || c == ')' || c == '+') continue;
-        cleaned += c;
+
+    for (int s = 0; s < S_STATES; ++s) {
+        for (int cls = 0; cls < E_CLASSES; ++cls) dfa.next[s][cls] = S_REJECT;
+        dfa.next[s][E_SPACE] = static_cast<unsigned char>(s);
+    }
+
+    // часть до @
+    for (int cls : {E_LETTER, E_DIGIT, E_LOCAL, E_DOT, E_HYPHEN}) {
+        dfa.next[S_START][cls] = S_LOCAL;
+        dfa.next[S_LOCAL][cls] = S_LOCAL;
+    }
+    dfa.next[S_LOCAL][E_AT] = S_AT;
+
+    // домен: первый символ любой допустимый (и точка - тогда она часть имени, а не последняя)
+    for (int cls : {E_LETTER, E_DIGIT, E_DOT, E_HYPHEN}) dfa.next[S_AT][cls] = S_DOMAIN;
+
+    for (int s : {S_DOMAIN, S_DOT, S_TLD1, S_TLD2}) {
+        dfa.next[s][E_DIGIT] = S_DOMAIN;
+        dfa.next[s][E_HYPHEN] = S_DOMAIN;
+        dfa.next[s][E_DOT] = S_DOT;
+    }
+    dfa.next[S_DOMAIN][E_LETTER] = S_DOMAIN;
+    dfa.next[S_DOT][E_LETTER] = S_TLD1;
+    dfa.next[S_TLD1][E_LETTER] = S_TLD2;
+    dfa.next[S_TLD2][E_LETTER] = S_TLD2;
+
+    return dfa;
+}
+
+constexpr EmailDfa EMAIL_DFA = build_email_dfa();
+
+} // namespace
+
+bool Validators::validate_email(string_view newEmail) {
+    unsigned char state = S_START;
+    for (char c : newEmail) {
+        state = EMAIL_DFA.next[state][EMAIL_DFA.charClass[static_cast<unsigned char>(c)]];
+        if (state == S_REJECT) return false;
     }
+    return state == S_TLD2;
+}
+
+// Телефон
+bool Validators::validate_phone(string_view phone) {
+    size_t begin, end;
+    trim_bounds(phone, begin, end);
+    if (begin == end) return false;
 
-    if (cleaned.empty()) return false;
+    // + в начале: номер должен начинаться с 7, иначе с 8
+    bool had_plus = phone[begin] == '+';
 
-    // Проверяем что все символы - цифры
-    for (char c : cleaned) {
+    // Пробелы, дефисы, скобки и плюсы пропускаем, остальное должно быть цифрами
+    size_t digits = 0;
+    char first_digit = 0;
+    for (size_t i = begin; i < end; i++) {
+        char c = phone[i];
+        if (c == ' ' || c == '-' || c == '(' || c == ')' || c == '+') continue;
         if (!isDigit(c)) return false;
+        if (digits == 0) first_digit = c;
+        ++digits;
     }
 
     // Проверяем длину
-    if (cleaned.size() != 11) return false;
-    
-    // Ключевое исправление: проверяем первый символ с учетом +
-    char first_digit = cleaned[0];
-    
-    if (had_plus) {
-        // Если был +, то первый символ должен быть 7
-        if (first_digit != '7') return false;
-    } else {
-        // Если не было +, то первый символ может быть 8
-        if (first_digit != '8') return false;
-    }
+    if (digits != 11) return false;
 
-    return true;
+    return first_digit == (had_plus ? '7' : '8');
 }
 
 // Дата рождения
-bool Validators::validate_birthDate(const string& birthDate) {
+bool Validators::validate_birthDate(string_view birthDate) {
     if (birthDate.empty()) return false;
     
     // Парсим дату из строки (ожидаем формат YYYY-MM-DD)
@@ -158,26 +198,39 @@ bool Validators::validate_birthDate(const string& birthDate) {
     return true;
 }
 
+// Число из куска строки по правилам stoi: пробелы в начале, знак, хотя бы одна цифра,
+// дальше цифры до первой не-цифры (остаток куска игнорируется). Без выделения памяти
+static bool parse_field(const char* text, size_t length, int& value) {
+    size_t i = 0;
+    while (i < length && (text[i] == ' ' || (text[i] >= '\t' && text[i] <= '\r'))) ++i;
+
+    bool negative = false;
+    if (i < length && (text[i] == '+' || text[i] == '-')) {
+        negative = text[i] == '-';
+        ++i;
+    }
+
+    if (i >= length || text[i] < '0' || text[i] > '9') return false; // stoi бросил бы исключение
+
+    int result = 0;
+    for (; i < length && text[i] >= '0' && text[i] <= '9'; ++i) {
+        result = result * 10 + (text[i] - '0');
+    }
+    value = negative ? -result : result;
+    return true;
+}
+
 // Парсинг даты из строки (формат DD.MM.YYYY)
-bool Validators::parse_date(const string& date_str, int& day, int& month, int& year) {
+bool Validators::parse_date(string_view date_str, int& day, int& month, int& year) {
     // Проверяем базовый формат
     if (date_str.length() != 10 || date_str[2] != '.' || date_str[5] != '.') {
         return false;
     }
-    
-    try {
-        // Парсинг дня (первые 2 символа)
-        day = stoi(date_str.substr(0, 2));    // "02.03.2006" -> "02" -> 2
-        
-        // Парсинг месяца (символы 3-4)
-        month = stoi(date_str.substr(3, 2));  // "02.03.2006" -> "03" -> 3
-        
-        // Парсинг года (символы 6-9)  
-        year = stoi(date_str.substr(6, 4));   // "02.03.2006" -> "2006" -> 2006
-        return true;
-    } catch (...) {
-        return false;
-    }
+
+    const char* text = date_str.data();
+    return parse_field(text, 2, day)         // "02.03.2006" -> "02" -> 2
+        && parse_field(text + 3, 2, month)   // "02.03.2006" -> "03" -> 3
+        && parse_field(text + 6, 4, year);   // "02.03.2006" -> "2006" -> 2006
 }
 
 // Количество дней в месяце с учетом високосного года
@@ -201,11 +254,8 @@ int Validators::days_in_month(int month, int year) {
 
 // Проверка что дата в прошлом (меньше текущей)
 bool Validators::is_past_date(int year, int month, int day) {
-    std::time_t t = std::time(nullptr);
-    std::tm* now = std::localtime(&t);
-    int currentYear = now->tm_year + 1900;
-    int currentMonth = now->tm_mon + 1;
-    int currentDay = now->tm_mday;
+    int currentYear, currentMonth, currentDay;
+    Date::today().to_ymd(currentYear, currentMonth, currentDay);   // потокобезопасно, в отличие от localtime
     
     if (year > currentYear) return false;
     if (year == currentYear && month > currentMonth) return false;
@@ -0,0 +1,200 @@
+#ifndef VALIDATORSREFERENCE_H
+#define VALIDATORSREFERENCE_H
+
+// Прежняя реализация Validators (std::regex, копии строк) - образец для сравнения.
+// Новые проверки должны принимать и отклонять ровно те же строки (tests/validators_diff.cpp),
+// а bench/validators_bench.cpp меряет, насколько они быстрее
+
+#include <string>
+#include <regex>
+#include <cctype>
+#include <ctime>
+
+using namespace std;
+
+namespace reference {
+
+// Вспомогательная функция для удаления пробелов по краям
+inline string trim(const string& str) {
+    size_t start = str.find_first_not_of(" \t\n\r");
+    if (start == string::npos) return "";
+
+    size_t end = str.find_last_not_of(" \t\n\r");
+    return str.substr(start, end - start + 1);
+}
+
+// Удаление всех пробелов
+inline string remove_spaces(const string& s) {
+    string out;
+    for (char c : s) {
+        if (!isspace(static_cast<unsigned char>(c)))
+            out += c;
+    }
+    return out;
+}
+
+inline bool isLetter(unsigned char c) {
+    if ((c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z')) return true;
+    if (c >= 0xC0) return true; // кириллица в UTF-8
+    return false;
+}
+
+inline bool isDigit(unsigned char c) {
+    return c >= '0' && c <= '9';
+}
+
+inline bool validate_name(const string& name) {
+    string name_trimmed = trim(name);
+    if (name_trimmed.empty()) return false;
+
+    if (name_trimmed.front() == '-' || name_trimmed.back() == '-')
+        return false;
+
+    if (!isLetter(name_trimmed.front()))
+        return false;
+
+    for (size_t i = 0; i < name_trimmed.size(); i++) {
+        unsigned char c = name_trimmed[i];
+        if (!(isLetter(c) || isDigit(c) || c == '-' || c == ' '))
+            return false;
+    }
+
+    return true;
+}
+
+inline bool validate_email(const string& newEmail) {
+    string email = remove_spaces(trim(newEmail));
+    if (email.empty()) return false;
+
+    static const regex email_regex(
+        R"(^[a-zA-Z0-9._%+-]+@[a-zA-Z0-9.-]+\.[a-zA-Z]{2,}$)"
+    );
+
+    return regex_match(email, email_regex);
+}
+
+inline bool validate_phone(const string& phone) {
+    string s = trim(phone);
+    if (s.empty()) return false;
+
+    string cleaned;
+    bool had_plus = false;
+
+    if (!s.empty() && s[0] == '+') {
+        had_plus = true;
+    }
+
+    for (char c : s) {
+        if (c == ' ' || c == '-' || c == '(' || c == ')' || c == '+') continue;
+        cleaned += c;
+    }
+
+    if (cleaned.empty()) return false;
+
+    for (char c : cleaned) {
+        if (!isDigit(c)) return false;
+    }
+
+    if (cleaned.size() != 11) return false;
+
+    char first_digit = cleaned[0];
+
+    if (had_plus) {
+        if (first_digit != '7') return false;
+    } else {
+        if (first_digit != '8') return false;
+    }
+
+    return true;
+}
+
+// Число из куска строки по правилам stoi
+inline bool parse_field(const char* text, size_t length, int& value) {
+    size_t i = 0;
+    while (i < length && (text[i] == ' ' || (text[i] >= '\t' && text[i] <= '\r'))) ++i;
+
+    bool negative = false;
+    if (i < length && (text[i] == '+' || text[i] == '-')) {
+        negative = text[i] == '-';
+        ++i;
+    }
+
+    if (i >= length || text[i] < '0' || text[i] > '9') return false;
+
+    int result = 0;
+    for (; i < length && text[i] >= '0' && text[i] <= '9'; ++i) {
+        result = result * 10 + (text[i] - '0');
+    }
+    value = negative ? -result : result;
+    return true;
+}
+
+inline bool parse_date(const string& date_str, int& day, int& month, int& year) {
+    if (date_str.length() != 10 || date_str[2] != '.' || date_str[5] != '.') {
+        return false;
+    }
+
+    const char* text = date_str.data();
+    return parse_field(text, 2, day)
+        && parse_field(text + 3, 2, month)
+        && parse_field(text + 6, 4, year);
+}
+
+inline int days_in_month(int month, int year) {
+    switch (month) {
+        case 1: case 3: case 5: case 7: case 8: case 10: case 12:
+            return 31;
+        case 4: case 6: case 9: case 11:
+            return 30;
+        case 2:
+            if ((year % 4 == 0 && year % 100 != 0) || (year % 400 == 0)) {
+                return 29;
+            } else {
+                return 28;
+            }
+        default:
+            return 0;
+    }
+}
+
+inline bool is_past_date(int year, int month, int day) {
+    time_t t = time(nullptr);
+    tm* now = localtime(&t);
+    int currentYear = now->tm_year + 1900;
+    int currentMonth = now->tm_mon + 1;
+    int currentDay = now->tm_mday;
+
+    if (year > currentYear) return false;
+    if (year == currentYear && month > currentMonth) return false;
+    if (year == currentYear && month == currentMonth && day > currentDay) return false;
+
+    return true;
+}
+
+inline bool validate_birthDate(const string& birthDate) {
+    if (birthDate.empty()) return false;
+
+    int day, month, year;
+    if (!parse_date(birthDate, day, month, year)) {
+        return false;
+    }
+
+    if (month < 1 || month > 12) {
+        return false;
+    }
+
+    if (day < 1 || day > days_in_month(month, year)) {
+        return false;
+    }
+
+    // аргументы в том же (перепутанном) порядке, что и в Validators
+    if (!is_past_date(day, month, year)) {
+        return false;
+    }
+
+    return true;
+}
+
+} // namespace reference
+
+#endif // VALIDATORSREFERENCE_H
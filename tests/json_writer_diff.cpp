@@ -0,0 +1,147 @@
+// Сравнение JsonWriter с nlohmann::json::dump: Style::Indented должен давать ровно dump(4),
+// Style::Compact - ровно dump() (невалидный UTF-8 - как у dump с error_handler_t::replace).
+// Проверяются случайные вложенные документы (кавычки, управляющие символы, правильный
+// и испорченный UTF-8, строки длиннее буфера) и Contact::writeJson против toJsonObj.
+// Сборка и запуск - см. README.md. Необязательный аргумент - число случайных документов
+
+#include "JsonWriter.h"
+#include "Contact.h"
+#include <iostream>
+#include <sstream>
+#include <random>
+#include <string>
+#include <cstdint>
+#include <cstdlib>
+
+using namespace std;
+
+namespace {
+
+mt19937_64 rng(25);
+
+// Кусочки строк: обычные символы, всё, что экранируется, кириллица, 4-байтовый символ
+// и неправильные последовательности (избыточная запись, суррогат, > U+10FFFF, обрывки)
+const char* PIECES[] = {"a", "Z", " ", "\"", "\\", "/", "\n", "\t", "\b", "\f", "\r", "\x01", "\x1f", "\x7f",
+                        "Ж", "€", "𝄞", "\xC0\x80", "\xED\xA0\x80", "\xF4\x90\x80\x80", "\xE0\x9F", "\xC3",
+                        "\xE2\x82", "\xFF", "\x80", "\xF0\x9F\x98"};
+const size_t PIECE_COUNT = sizeof(PIECES) / sizeof(PIECES[0]);
+
+string random_string(size_t maxPieces) {
+    string s;
+    for (size_t n = rng() % (maxPieces + 1); n > 0; --n) {
+        if (rng() % 4 == 0) s += static_cast<char>(rng() % 256);
+        else s += PIECES[rng() % PIECE_COUNT];
+    }
+    return s;
+}
+
+json random_json(int depth) {
+    switch (depth > 3 ? rng() % 2 : rng() % 4) {
+        case 0: return random_string(12);
+        case 1: return static_cast<int64_t>(rng() % 2000) - 1000;
+        case 2: {
+            json array = json::array();
+            for (int n = rng() % 4; n > 0; --n) array.push_back(random_json(depth + 1));
+            return array;
+        }
+        default: {
+            json object = json::object();
+            for (int n = rng() % 4; n > 0; --n) object[random_string(4)] = random_json(depth + 1);
+            return object;
+        }
+    }
+}
+
+// Повторить документ через JsonWriter (nlohmann перебирает ключи объекта по алфавиту)
+void write(JsonWriter& writer, const json& value) {
+    if (value.is_object()) {
+        writer.begin_object();
+        for (auto it = value.begin(); it != value.end(); ++it) {
+            writer.key(it.key());
+            write(writer, it.value());
+        }
+        writer.end_object();
+    } else if (value.is_array()) {
+        writer.begin_array();
+        for (const auto& item : value) write(writer, item);
+        writer.end_array();
+    } else if (value.is_string()) {
+        writer.value(value.get_ref<const string&>());
+    } else {
+        writer.value(value.get<int64_t>());
+    }
+}
+
+string expected_dump(const json& value, JsonWriter::Style style) {
+    return value.dump(style == JsonWriter::Style::Indented ? 4 : -1, ' ', false, json::error_handler_t::replace);
+}
+
+size_t g_failures = 0;
+
+void check(const string& what, const string& actual, const string& expected) {
+    if (actual == expected) return;
+    if (++g_failures <= 5) cerr << what << " differs:\n" << actual << "\n--- expected ---\n" << expected << "\n";
+}
+
+void check_document(const json& value) {
+    for (auto style : {JsonWriter::Style::Indented, JsonWriter::Style::Compact}) {
+        ostringstream out;
+        {
+            JsonWriter writer(out, style);
+            write(writer, value);
+        }
+        check("document", out.str(), expected_dump(value, style));
+    }
+}
+
+void check_contact(const Contact& contact) {
+    for (auto style : {JsonWriter::Style::Indented, JsonWriter::Style::Compact}) {
+        ostringstream out;
+        {
+            JsonWriter writer(out, style);
+            contact.writeJson(writer);
+        }
+        check("contact", out.str(), expected_dump(contact.toJsonObj(), style));
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const long documents = argc > 1 ? atol(argv[1]) : 100000;
+
+    // пустые контейнеры и верхний уровень без вложенности
+    for (const char* text : {"[]", "{}", "[[]]", "{\"a\":{}}", "[{}, []]", "\"x\"", "-5"}) check_document(json::parse(text));
+
+    for (long i = 0; i < documents; ++i) check_document(random_json(0));
+
+    // строки и документ длиннее буфера JsonWriter
+    json longStrings = json::array();
+    for (size_t i = 0; i < 5; ++i) {
+        longStrings.push_back(string(JsonWriter::BUFFER_SIZE + 1000 * i + 7, 'x') + "\"\n" + string(JsonWriter::BUFFER_SIZE, 'y'));
+    }
+    check_document(longStrings);
+
+    // контакты: все поля, экранирование, пустые поля и телефоны
+    for (int i = 0; i < 1000; ++i) {
+        json record;
+        record["firstName"] = "Иван" + to_string(i);
+        record["lastName"] = "Пет\"ров\\";
+        record["patronymic"] = i % 3 ? "" : "Ок\tт";
+        record["address"] = "ул. \x01 Ленина, " + to_string(i);
+        record["birthDate"] = i % 5 ? "01.02.1990" : "";
+        record["email"] = "u" + to_string(i) + "@mail.ru";
+        record["phones"] = json::array();
+        for (int p = 0; p < i % 4; ++p) {
+            record["phones"].push_back({{"number", "+7912" + to_string(1000000 + i * 4 + p)}, {"type", p % 3}});
+        }
+        check_contact(Contact::fromJson(record.dump()));
+    }
+
+    if (g_failures > 0) {
+        cerr << "json_writer_diff: " << g_failures << " mismatches\n";
+        return 1;
+    }
+    cout << "json_writer_diff: OK (" << documents << " documents)\n";
+    return 0;
+}
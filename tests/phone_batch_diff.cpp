@@ -0,0 +1,127 @@
+// Сравнение PhoneBatch::normalize с поштучной проверкой: для каждого номера бит валидности
+// должен совпасть с Validators::validate_phone, а ключ - с PhoneNumber::key_of (0 для невалидных).
+// Проверяется каждое ядро, которое поддерживает процессор (Scalar, SSSE3, AVX2), отдельно.
+// Сборка и запуск - см. README.md. Необязательный аргумент - число случайных пакетов
+
+#include "PhoneBatch.h"
+#include "PhoneNumber.h"
+#include "Validators.h"
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include <memory>
+#include <cstring>
+#include <cstdlib>
+
+using namespace std;
+
+namespace {
+
+mt19937 rng(22);
+
+string random_string(const string& alphabet, size_t maxLength) {
+    size_t length = rng() % maxLength;
+    string s;
+    for (size_t i = 0; i < length; ++i) s += alphabet[rng() % alphabet.size()];
+    return s;
+}
+
+// Правильные записи с мелкими правками (вставка, удаление, замена символа) или случайный мусор
+string make_phone() {
+    static const char* FORMATS[] = {"+7(812)123-45-67", "88121234567", "+7 921 000 11 22", "8(812)1234567",
+                                    "+78121234567", "7 812 123 45 67", "+8(812)123-45-67", " +7(812)1234567\r\n",
+                                    "\t8 (921) 000-11-22 \n", "+7 (921) 000 - 11 - 22"};
+    if (rng() % 3) {
+        string s = FORMATS[rng() % 10];
+        for (int k = rng() % 3; k > 0; --k) {
+            size_t i = rng() % (s.size() + 1);
+            switch (rng() % 3) {
+                case 0: s.insert(i, 1, string(" -()+0\t9x\n\r\0", 12)[rng() % 12]); break;
+                case 1: if (i < s.size()) s.erase(i, 1); break;
+                default: if (i < s.size()) s[i] = "0123456789+ \t"[rng() % 13]; break;
+            }
+        }
+        return s;
+    }
+    return random_string(string("78(1)2- 3+0\t9a\n\r\x80\0", 16), rng() % 2 ? 14 : 40);
+}
+
+// Правильные номера, раздутые разделителями до любой длины: номер пересекает границы
+// 16- и 32-байтных блоков в разных местах
+vector<string> boundary_phones() {
+    vector<string> out;
+    for (const char* base : {"+78121234567", "88121234567", "+79210001122"}) {
+        for (size_t pad = 0; pad < 48; ++pad) {
+            out.push_back(string(pad, ' ') + base);
+            out.push_back(base + string(pad, ' '));
+            string spread = base;
+            for (size_t i = 0; i < pad; ++i) spread.insert(1 + rng() % (spread.size() - 1), 1, "-() "[rng() % 4]);
+            out.push_back(spread);
+        }
+    }
+    return out;
+}
+
+size_t g_failures = 0;
+
+void check_batch(const vector<string>& numbers, PhoneBatch::Kernel kernel) {
+    const size_t count = numbers.size();
+
+    // столбец ровно нужного размера - чтение последних номеров идёт через копию хвоста
+    vector<size_t> offsets{0};
+    for (const auto& s : numbers) offsets.push_back(offsets.back() + s.size());
+    unique_ptr<char[]> data(new char[offsets.back() + 1]);
+    for (size_t i = 0; i < count; ++i) memcpy(data.get() + offsets[i], numbers[i].data(), numbers[i].size());
+
+    // лишнее слово и лишний ключ в конце - чтобы заметить запись за границу
+    vector<uint64_t> keys(count + 1, 123), valid((count + 63) / 64 + 1, ~0ULL);
+    const size_t validCount = PhoneBatch::normalize(data.get(), offsets.data(), count, keys.data(), valid.data(), kernel);
+
+    size_t expectedCount = 0;
+    for (size_t i = 0; i < count; ++i) {
+        const bool expected = Validators::validate_phone(numbers[i]);
+        const bool actual = (valid[i / 64] >> (i % 64)) & 1;
+        const uint64_t expectedKey = expected ? PhoneNumber::key_of(numbers[i]) : 0;
+        expectedCount += expected;
+        if (actual != expected || keys[i] != expectedKey) {
+            if (++g_failures <= 10) {
+                cerr << PhoneBatch::kernel_name(kernel) << " differs on [" << numbers[i] << "]: valid "
+                     << actual << " (expected " << expected << "), key " << keys[i] << " (expected " << expectedKey << ")\n";
+            }
+        }
+    }
+    if (validCount != expectedCount || keys[count] != 123) {
+        if (++g_failures <= 10) cerr << PhoneBatch::kernel_name(kernel) << ": wrong count or write past the end\n";
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const long batches = argc > 1 ? atol(argv[1]) : 2000;
+
+    vector<PhoneBatch::Kernel> kernels;
+    for (auto kernel : {PhoneBatch::Kernel::Scalar, PhoneBatch::Kernel::SSSE3, PhoneBatch::Kernel::AVX2}) {
+        // normalize молча заменяет неподдерживаемое ядро на лучшее доступное - такие не проверяем
+        if (static_cast<int>(kernel) <= static_cast<int>(PhoneBatch::best_kernel())) kernels.push_back(kernel);
+    }
+
+    const vector<string> boundary = boundary_phones();
+    for (auto kernel : kernels) check_batch(boundary, kernel);
+
+    for (long t = 0; t < batches; ++t) {
+        vector<string> numbers;
+        for (size_t i = rng() % 700; i > 0; --i) numbers.push_back(make_phone());
+        for (auto kernel : kernels) check_batch(numbers, kernel);
+    }
+
+    if (g_failures > 0) {
+        cerr << "phone_batch_diff: " << g_failures << " mismatches\n";
+        return 1;
+    }
+    cout << "phone_batch_diff: OK (" << batches << " batches; kernels:";
+    for (auto kernel : kernels) cout << " " << PhoneBatch::kernel_name(kernel);
+    cout << ")\n";
+    return 0;
+}
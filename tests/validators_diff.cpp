@@ -0,0 +1,120 @@
+// Сравнение Validators с прежней реализацией на regex (tests/ValidatorsReference.h):
+// на случайных и испорченных строках ответы должны совпадать.
+// Сборка и запуск - см. README.md. Необязательный аргумент - число случайных наборов
+
+#include "Validators.h"
+#include "ValidatorsReference.h"
+#include <iostream>
+#include <random>
+#include <string>
+#include <cstdio>
+#include <cstdlib>
+
+using namespace std;
+
+namespace {
+
+mt19937 rng(21);
+
+string random_string(const string& alphabet, size_t maxLength) {
+    size_t length = rng() % maxLength;
+    string s;
+    for (size_t i = 0; i < length; ++i) s += alphabet[rng() % alphabet.size()];
+    return s;
+}
+
+// Похожие на email строки: части адреса, лишние @ и точки, пробельные символы и мусор
+string make_email() {
+    static const char* SPACES[] = {" ", "\t", "\n", "\v", "\f", "\r", "\xA0"};
+    string s;
+    if (rng() % 6) s += random_string("aZ09._%+-\xD0\xB1", 6);
+    if (rng() % 8) s += '@';
+    if (rng() % 10 == 0) s += '@';
+    if (rng() % 6) s += random_string("aZ09.-", 6);
+    if (rng() % 6) s += '.';
+    s += random_string(rng() % 3 ? "abcXY" : "ab1.-", 5);
+    for (int k = rng() % 3; k > 0; --k) s.insert(rng() % (s.size() + 1), SPACES[rng() % 7]);
+    if (rng() % 20 == 0 && !s.empty()) s[rng() % s.size()] = static_cast<char>(rng() % 256);
+    return s;
+}
+
+// Правильные записи телефона с мелкими правками или случайный набор цифр и разделителей
+string make_phone() {
+    static const char* FORMATS[] = {"+7(812)123-45-67", "88121234567", "+7 921 000 11 22", "8(812)1234567",
+                                    "+78121234567", "7 812 123 45 67", "+8(812)123-45-67", " +7(812)1234567\r\n"};
+    if (rng() % 2) {
+        string s = FORMATS[rng() % 8];
+        for (int k = rng() % 3; k > 0; --k) {
+            size_t i = rng() % (s.size() + 1);
+            switch (rng() % 3) {
+                case 0: s.insert(i, 1, " -()+0\t9x"[rng() % 9]); break;
+                case 1: if (i < s.size()) s.erase(i, 1); break;
+                default: if (i < s.size()) s[i] = "0123456789+"[rng() % 11]; break;
+            }
+        }
+        return s;
+    }
+    string s;
+    if (rng() % 3 == 0) s += " \t"[rng() % 2];
+    if (rng() % 2) s += '+';
+    s += random_string("78(1)2- 3+0\t9a", 14);
+    if (rng() % 3 == 0) s += "\r\n "[rng() % 3];
+    return s;
+}
+
+string make_name() {
+    return random_string(string(" \t\r\naZ-9\xD0\xB8\xC0\x80\x01_ ", 15), 10);
+}
+
+string make_date() {
+    if (rng() % 4 == 0) return random_string("0123456789. -+", 11);
+    char text[16];
+    snprintf(text, sizeof(text), "%02d.%02d.%04d", int(rng() % 40), int(rng() % 14), int(1900 + rng() % 200));
+    return text;
+}
+
+size_t g_failures = 0;
+
+void check(const char* what, const string& input, bool actual, bool expected) {
+    if (actual == expected) return;
+    if (++g_failures <= 10) {
+        cerr << what << " differs on [" << input << "]: new " << actual << ", reference " << expected << "\n";
+    }
+}
+
+void check_email(const string& s) { check("validate_email", s, Validators::validate_email(s), reference::validate_email(s)); }
+void check_phone(const string& s) { check("validate_phone", s, Validators::validate_phone(s), reference::validate_phone(s)); }
+void check_name(const string& s)  { check("validate_name", s, Validators::validate_name(s), reference::validate_name(s)); }
+void check_date(const string& s)  { check("validate_birthDate", s, Validators::validate_birthDate(s), reference::validate_birthDate(s)); }
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const long rounds = argc > 1 ? atol(argv[1]) : 1000000;
+
+    // пограничные случаи грамматики email
+    for (const char* s : {"a@b.cc", "a@.cc", "a@..cc", "a@b.c", "a@b.c1", "a@b.cc.", "a@-.cc", " a @ b . cc ",
+                          "a@b@c.cc", "@b.cc", "a@b.ccc9", "a@b.c-c.dd", "a.b%c+d-e_f@x-y.z.RU", "a@bcc", ""}) {
+        check_email(s);
+    }
+
+    for (long i = 0; i < rounds; ++i) {
+        // произвольные байты - для всех проверок сразу
+        const string noise = random_string(string("\x00\x01 \t.@aZ9-+()_%\x80\xFF", 17), 12);
+        check_email(make_email());
+        check_email(noise);
+        check_phone(make_phone());
+        check_phone(noise);
+        check_name(make_name());
+        check_name(noise);
+        check_date(make_date());
+        check_date(noise);
+    }
+
+    if (g_failures > 0) {
+        cerr << "validators_diff: " << g_failures << " mismatches\n";
+        return 1;
+    }
+    cout << "validators_diff: OK (" << rounds << " rounds)\n";
+    return 0;
+}